@@ -53,7 +53,7 @@
 // the memory framebuffer for the LCD
 ////
 ///uint8_t st7558_buffer[918];
-uint8_t st7558_buffer[9][102];
+uint8_t st7558_buffer[ST7558_PAGES][ST7558_RAM_WIDTH];
 //#define enablePartialUpdate
 
 #ifdef enablePartialUpdate
@@ -86,11 +86,44 @@ static void updateBoundingBox(uint8_t xmin, uint8_t ymin, uint8_t xmax, uint8_t
 #endif
 }
 
+// Dirty box of a primitive, controller space. Inside a batch endWrite()
+// accounts for it.
+void ST7558::dirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  if (!writeDepth)
+    addDirty(x0, y0, x1, y1);
+}
+
+// Grow the bounding box and the current layer's page spans
+void ST7558::addDirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  uint8_t page, lastPage;
+
+  updateBoundingBox(x0, y0, x1, y1);
+  if (x0 < 0) x0 = 0;
+  if (y0 < 0) y0 = 0;
+  if (x1 > ST7558_RAM_WIDTH - 1) x1 = ST7558_RAM_WIDTH - 1;
+  if (y1 > ST7558_PAGES * 8 - 1) y1 = ST7558_PAGES * 8 - 1;
+  if ((x0 > x1) || (y0 > y1)) return;
+  lastPage = y1 >> 3;
+  for (page = y0 >> 3; page <= lastPage; page++) {
+    if (x0 < spanX0[layer][page]) spanX0[layer][page] = x0;
+    if (x1 > spanX1[layer][page]) spanX1[layer][page] = x1;
+  }
+}
+
 ST7558::ST7558( uint8_t rst)
- : Core_GFX(ST7558_WIDTH, ST7558_HEIGHT)
+ : ST7558_Surface(ST7558_WIDTH, ST7558_HEIGHT, st7558_buffer[0],
+     ST7558_RAM_WIDTH)
 {
  _rst  = rst;
  BlLevel = BACKHLIGHT_MAX;
+ writeDepth = 0;
+ layers[0].bits = st7558_buffer;
+ layers[0].rop = ST7558_ROP_COPY;
+ layers[0].visible = true;
+ layerCount = layer = 0;
+ memset(spanX0, 0xFF, sizeof(spanX0));
+ memset(spanX1, 0, sizeof(spanX1));
+ clipChanged();
 
 }
 ST7558::~ST7558() {
@@ -188,7 +221,7 @@ void ST7558::init(uint8_t sda, uint8_t scl) {
   i2cwrite(cmd_init, sizeof(cmd_init));
   setAddrXY(0, 0);
   // set up a bounding box for screen updates
-  updateBoundingBox(0, 0, _width-1, _height-1);
+  addDirty(0, 0, _width-1, _height-1);
   
 }
 /*
@@ -270,7 +303,7 @@ void ST7558::display(void) {
 		
 		for (col = 0; col < 6; col++) {
 			for (i = 0; i < 17; i++) {
-				buff[i+1] = st7558_buffer[page][(col*17) + i];
+				buff[i+1] = compose(page, (col*17) + i);
 			}
 			setAddrXY((col*17), page);
 			i2cwrite(buff, sizeof(buff));
@@ -281,6 +314,8 @@ void ST7558::display(void) {
 	}
 	displayOn();
 	setAddrXY(0, 0);
+	memset(spanX0, 0xFF, sizeof(spanX0));
+	memset(spanX1, 0, sizeof(spanX1));
 
 	//command(PCD8544_SETYADDR );  // no idea why this is necessary but it is to finish the last byte?
 
@@ -289,44 +324,104 @@ void ST7558::display(void) {
 
 // original
 
+// Send n framebuffer bytes of one page from column x, leaving the rest of
+// the display as it is
+void ST7558::displaySpan(uint8_t page, uint8_t x, uint8_t n) {
+	uint8_t buff[18], i;
 
-void ST7558::drawPixel(int16_t x, int16_t y,  uint16_t color) {
-  
-	
-  //// 
-
-int16_t t;
-if ((x < 0) || (x >= _width) || (y < 0) || (y >= _height)) return;
-
-switch(rotation){
-    case 1:
-      t = x;
-      x = y;
-      y = HEIGHT-1-t;
-      break;
-    case 2:
-      x = WIDTH - 1 - x;
-      y = HEIGHT - 1 - y;
-      break;
-    case 3:
-      t = x;
-      x = WIDTH - 1 - y;
-      y = t;
-      break;
-  }
-  
-   // x is which column    ????_width
-	 if (!color) {
-	  //st7558_buffer[x + (y / 8)*_width] |= _BV(y % 8);
-	  st7558_buffer[int(y / 8)][ x] |= _BV(y % 8);
+	buff[0] = CONTROL_RS_RAM;
+	while (n) {
+		setAddrXY(x, page);
+		for (i = 1; (i < sizeof(buff)) && n; i++, x++, n--)
+			buff[i] = compose(page, x);
+		i2cwrite(buff, i);
+	}
+}
 
-	  
+// One display byte: the framebuffer with the visible overlays combined
+// over it, bottom up
+uint8_t ST7558::compose(uint8_t page, uint8_t x) {
+  uint8_t b = st7558_buffer[page][x], n;
+
+  for (n = 1; n <= layerCount; n++)
+    if (layers[n].visible)
+      b = st7558_rop(b, layers[n].bits[page][x], 0xFF, layers[n].rop);
+  return b;
+}
+
+// Send the columns any layer changed since the last flush() or display()
+void ST7558::flush(void) {
+  uint8_t page, n, x0, x1;
+
+  for (page = 0; page < ST7558_PAGES; page++) {
+    x0 = 0xFF;
+    x1 = 0;
+    for (n = 0; n <= layerCount; n++) {
+      if (spanX0[n][page] < x0) x0 = spanX0[n][page];
+      if (spanX1[n][page] > x1) x1 = spanX1[n][page];
+      spanX0[n][page] = 0xFF;
+      spanX1[n][page] = 0;
+    }
+    if (x0 <= x1)
+      displaySpan(page, x0, x1 - x0 + 1);
   }
-  else
-     // st7558_buffer[x+ (y / 8)*_width] &= ~_BV(y % 8);
-		st7558_buffer[int(y / 8)][x] &= ~_BV(y % 8);
+}
+
+uint8_t ST7558::addLayer(uint8_t (*bits)[ST7558_RAM_WIDTH], uint8_t rop) {
+  if (layerCount == ST7558_LAYERS_MAX) return 0;
+  layerCount++;
+  memset(bits, 0, ST7558_PAGES * ST7558_RAM_WIDTH);
+  layers[layerCount].bits = bits;
+  layers[layerCount].rop = rop;
+  layers[layerCount].visible = true;
+  return layerCount;
+}
+
+void ST7558::setLayer(uint8_t n) {
+  if (n > layerCount) return;
+  if (writeDepth && (clipX0 <= clipX1))
+    addDirty(clipX0, clipY0, clipX1, clipY1);   // batch drew on the old one
+  layer = n;
+  bits = layers[n].bits[0];
+}
+
+void ST7558::setLayerRop(uint8_t n, uint8_t rop) {
+  if ((n == 0) || (n > layerCount) || (layers[n].rop == rop)) return;
+  layers[n].rop = rop;
+  layerDirty(n);
+}
 
-  updateBoundingBox(x,y,x,y);
+void ST7558::showLayer(uint8_t n, boolean show) {
+  if ((n == 0) || (n > layerCount) || (layers[n].visible == show)) return;
+  layers[n].visible = show;
+  layerDirty(n);
+}
+
+// All of layer n needs sending again
+void ST7558::layerDirty(uint8_t n) {
+  memset(spanX0[n], 0, ST7558_PAGES);
+  memset(spanX1[n], ST7558_RAM_WIDTH - 1, ST7558_PAGES);
+}
+
+
+// Inside a batch the old clip rectangle is what the batch drew through
+void ST7558::clipChanged(void) {
+  if (writeDepth && (clipX0 <= clipX1))
+    addDirty(clipX0, clipY0, clipX1, clipY1);   // batch drew here
+  ST7558_Surface::clipChanged();
+}
+
+// A batch skips the per primitive dirty boxes and marks every clip
+// rectangle it drew through dirty once, when it ends (see clipChanged()).
+// Narrow the clip rectangle around a batch to keep partial updates small.
+void ST7558::startWrite(void) {
+  writeDepth++;
+}
+
+void ST7558::endWrite(void) {
+  if (!writeDepth) return;
+  if ((--writeDepth == 0) && (clipX0 <= clipX1))
+    addDirty(clipX0, clipY0, clipX1, clipY1);
 }
 
 uint8_t ST7558::getPixel(int8_t x, int8_t y) {
@@ -334,7 +429,7 @@ uint8_t ST7558::getPixel(int8_t x, int8_t y) {
     return 0;
 
  // return (st7558_buffer[x+ (y/8)*_width] >> (y%8)) & 0x1;  
-  return (st7558_buffer[int(y / 8)][ x] >> (y % 8)) & 0x1;
+  return (bits[int(y / 8) * stride + x] >> (y % 8)) & 0x1;
 
 }
 
@@ -345,38 +440,32 @@ uint8_t ST7558::getPixel(int8_t x, int8_t y, const uint8_t *bitmap, uint8_t w, u
   return (pgm_read_byte(bitmap + (y/8)*w + x) >> (y%8)) & 0x1;  
 }
 
-void ST7558::drawFastVLine(int16_t x, int16_t y, int16_t h,  uint16_t color){
-  
-  if((x >= _width) || (y >= _height)) return;
-  if((y+h-1) >= _height) h = _height-y;
-  
-  for(uint8_t i=y; i<y+h; i++)
-     drawPixel(x, i, color);
-}
-
-void ST7558::drawFastHLine(int16_t x, int16_t y, int16_t w,  uint16_t color){
-  
-  if((x >= _width) || (y >= _height)) return;
-  if((x+w-1) >= _width)  w = _width-x;
-  
-  for(uint8_t i=x; i<x+w; i++)
-     drawPixel(i, y, color);
-}
-
-void ST7558::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
-  uint16_t color) {
-  
-  int16_t i, j;
-  
-  if((x >= _width) || (y >= _height)) return;
-  if((x + w - 1) >= _width)  w = _width  - x;
-  if((y + h - 1) >= _height) h = _height - y;
-  
-  for(j=h; j>0; j--) {
-    for(i=w; i>0; i--) {
-      drawPixel(x+i, y+j, color);
+// Decode a packed image at the top left of the display RAM, straight onto
+// the I2C bus. The framebuffer is left alone, so the next display()
+// replaces the image.
+void ST7558::displayPacked(const uint8_t *packed) {
+  ST7558_Unpacker u(packed);
+  uint8_t w = pgm_read_byte(packed), h = pgm_read_byte(packed + 1);
+  uint8_t buff[17], page, pages, col, i;
+
+  buff[0] = CONTROL_RS_RAM;
+  pages = (h + 7) >> 3;
+  for (page = 0; page < pages; page++) {
+    if (page >= ST7558_PAGES) break;
+    for (col = 0; col < w; ) {
+      if (col >= ST7558_RAM_WIDTH) {
+        u.skip(w - col);
+        break;
+      }
+      setAddrXY(col, page);
+      for (i = 1; (i < sizeof(buff)) && (col < w) && (col < ST7558_RAM_WIDTH);
+           i++, col++)
+        buff[i] = u.next();
+      i2cwrite(buff, i);
     }
   }
+  displayOn();
+  setAddrXY(0, 0);
 }
 
 void ST7558::invertDisplay(boolean i){
@@ -397,13 +486,16 @@ void ST7558::clearDisplay(void) {
 }
 */
 void ST7558::clearDisplay(void) {
-	memset(st7558_buffer, 0, sizeof(st7558_buffer));
-	updateBoundingBox(0, 0, _width - 1, _height - 1);
+	memset(bits, 0, sizeof(st7558_buffer));
+	addDirty(0, 0, ST7558_RAM_WIDTH - 1, ST7558_PAGES * 8 - 1);
 	cursor_y = cursor_x = 0;
 }
 
+// Cursor to a character cell: text line 0..ST7558_MAX_TEXT_LINE, column
+// ('row') 0..ST7558_MAX_TEXT_ROW, in cells of the current text size
 void ST7558::SetTextPosition(uint8_t line, uint8_t row) {
-
-	
+	line = min(line, ST7558_MAX_TEXT_LINE);
+	row = min(row, ST7558_MAX_TEXT_ROW);
+	setCursor(row * textsize * 6, line * textsize * 8);
 }
 
@@ -38,15 +38,19 @@
   #include "WProgram.h"
   #include "pins_arduino.h"
 #endif
-#include <Core_GFX.h>
+#include "ST7558_Surface.h"
 #define BACKHLIGHT_MAX 255
 #define ST7558_WIDTH    96 //96  // 94 visibles de 102 (de 0 a 95)
 #define ST7558_HEIGHT   65  // 64 visibles de 65 (de 0 a 64)
+#define ST7558_PAGES    9   // 8 pixel high pages of display RAM
+#define ST7558_RAM_WIDTH 102 // columns of display RAM per page
 #define ST7558_MAX_TEXT_LINE 7
 #define	ST7558_MAX_TEXT_ROW 15
 #define ST7558_BLACK    0
 #define ST7558_WHITE    1
 
+#define ST7558_LAYERS_MAX 2 // overlay layers above the framebuffer
+
 #define I2C_ADDR_DISPLAY  0x3C
 
 #define MORE_CONTROL        0x80
@@ -76,7 +80,10 @@
 #define ST7558_SETVOP 0x80
 
 
-class ST7558 : public Core_GFX {
+// the memory framebuffer for the LCD, one byte per column and page, LSB on top
+extern uint8_t st7558_buffer[ST7558_PAGES][ST7558_RAM_WIDTH];
+
+class ST7558 : public ST7558_Surface {
 
   public:
  
@@ -89,11 +96,10 @@ class ST7558 : public Core_GFX {
 		SetBacklightLevel(uint8_t level),
 		display(void),
 		display1(void),
-		drawPixel(int16_t posX, int16_t posY, uint16_t color),
+		displaySpan(uint8_t page, uint8_t x, uint8_t n),
 		setContrast(uint8_t val),
-		drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color),
-		drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color),
-		fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color),
+		startWrite(void),
+		endWrite(void),
 		invertDisplay(boolean i),
 		displayOff(void),
 		displayOn(void),
@@ -101,18 +107,54 @@ class ST7558 : public Core_GFX {
 		SetTextPosition(uint8_t line, uint8_t row);
 		
 		
+  // Packed bitmap (see ST7558_Pack.h), PROGMEM, sent straight to the
+  // top left of the display
+  void displayPacked(const uint8_t *packed);
+
+  // Layers. Layer 0 is st7558_buffer; overlays are caller supplied
+  // buffers of the same size, combined over the layers below with their
+  // raster op as the bytes go out to the display. Every layer keeps its
+  // own dirty column span per page, so a static layer drawn once costs
+  // nothing until something above or below it changes. addLayer() clears
+  // the buffer and returns the layer number, 0 when all are taken.
+  uint8_t addLayer(uint8_t (*bits)[ST7558_RAM_WIDTH],
+            uint8_t rop = ST7558_ROP_OR);
+  void setLayer(uint8_t n),                   // drawing goes to layer n
+       setLayerRop(uint8_t n, uint8_t rop),
+       showLayer(uint8_t n, boolean show),
+       flush(void);                           // send the dirty spans
+  uint8_t getLayer(void) const { return layer; }
+
   uint8_t getPixel(int8_t x, int8_t y),
               getPixel(int8_t x, int8_t y, const uint8_t *bitmap, uint8_t w, uint8_t h);
-           
-  
+
+  protected:
+    void clipChanged(void),
+         dirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
   private:
+    friend class ST7558_Sprites;
+
 	   void i2cwrite(uint8_t *data, uint8_t len),
             hwReset(void),
-            setAddrXY(uint8_t x, uint8_t pageY);
+            setAddrXY(uint8_t x, uint8_t pageY),
+            addDirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1),
+            layerDirty(uint8_t n);
+    uint8_t compose(uint8_t page, uint8_t x);
 
     uint8_t _rst, BacklightGPIO = 13,BlLevel,
                 colstart, rowstart, _sda, _scl;
-    
+    uint8_t writeDepth;                       // startWrite() nesting
+
+    struct {
+      uint8_t (*bits)[ST7558_RAM_WIDTH];
+      uint8_t rop;
+      boolean visible;
+    } layers[ST7558_LAYERS_MAX + 1];
+    uint8_t layerCount, layer;
+    // Dirty columns spanX0..spanX1 of each layer and page, none if x0 > x1
+    uint8_t spanX0[ST7558_LAYERS_MAX + 1][ST7558_PAGES],
+            spanX1[ST7558_LAYERS_MAX + 1][ST7558_PAGES];
 };
 
 #endif
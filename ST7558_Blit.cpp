@@ -0,0 +1,182 @@
+/***************************************************
+  Page-format bitmap blitter for the ST7558 library.
+ ****************************************************/
+
+#ifdef __AVR__
+ #include <avr/pgmspace.h>
+#elif defined(ESP8266)
+ #include <pgmspace.h>
+#endif
+
+#ifndef pgm_read_byte
+ #define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#endif
+
+#include "ST7558_Blit.h"
+
+void st7558_blit(uint8_t *dst, uint8_t stride, int16_t x, int16_t y,
+  const uint8_t *src, int16_t w, int16_t h,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  uint8_t rop, boolean progmem) {
+
+  int16_t page, lastPage, r, q, s, c, n, srcPages;
+  const uint8_t *lo, *hi;
+  uint8_t mask, bits, *d;
+
+  if ((w <= 0) || (h <= 0)) return;
+  if (x0 < x) x0 = x;
+  if (y0 < y) y0 = y;
+  if (x1 > x + w - 1) x1 = x + w - 1;
+  if (y1 > y + h - 1) y1 = y + h - 1;
+  if ((x0 > x1) || (y0 > y1)) return;
+
+  srcPages = (h + 7) >> 3;
+  lastPage = y1 >> 3;
+  for (page = y0 >> 3; page <= lastPage; page++) {
+    mask = 0xFF;
+    if (page == (y0 >> 3)) mask &= 0xFF << (y0 & 7);
+    if (page == lastPage)  mask &= 0xFF >> (7 - (y1 & 7));
+
+    // Source row landing on bit 0 of this page: row r of source page q is
+    // shifted down by s, the next source page fills the top
+    r = page * 8 - y;
+    q = (r + 8) / 8 - 1;
+    s = r - q * 8;
+    lo = (q >= 0) ? src + q * w : NULL;
+    hi = (s && (q + 1 < srcPages)) ? src + (q + 1) * w : NULL;
+
+    d = dst + page * stride + x0;
+    c = x0 - x;
+    for (n = x1 - x0 + 1; n--; c++, d++) {
+      bits = 0;
+      if (lo) bits  = (progmem ? pgm_read_byte(lo + c) : lo[c]) >> s;
+      if (hi) bits |= (progmem ? pgm_read_byte(hi + c) : hi[c]) << (8 - s);
+      *d = st7558_rop(*d, bits, mask, rop);
+    }
+  }
+}
+
+#ifdef __AVR__
+// Shift and OR, unrolled: no multi-bit shifts, which AVR does one bit at a
+// time, and no 32 bit words
+#define COLLECT(j) \
+  b = in[j]; \
+  o0 = (o0 << 1) | (b & 1); b >>= 1; \
+  o1 = (o1 << 1) | (b & 1); b >>= 1; \
+  o2 = (o2 << 1) | (b & 1); b >>= 1; \
+  o3 = (o3 << 1) | (b & 1); b >>= 1; \
+  o4 = (o4 << 1) | (b & 1); b >>= 1; \
+  o5 = (o5 << 1) | (b & 1); b >>= 1; \
+  o6 = (o6 << 1) | (b & 1); b >>= 1; \
+  o7 = (o7 << 1) | b;
+
+void st7558_transpose8(const uint8_t *in, uint8_t *out) {
+  uint8_t b, o0 = 0, o1 = 0, o2 = 0, o3 = 0, o4 = 0, o5 = 0, o6 = 0, o7 = 0;
+
+  COLLECT(7) COLLECT(6) COLLECT(5) COLLECT(4)
+  COLLECT(3) COLLECT(2) COLLECT(1) COLLECT(0)
+  out[0] = o0; out[1] = o1; out[2] = o2; out[3] = o3;
+  out[4] = o4; out[5] = o5; out[6] = o6; out[7] = o7;
+}
+#undef COLLECT
+
+#else
+// SWAR on two 32 bit words: swap 1x1, 2x2 then 4x4 bit blocks across the
+// diagonal (Hacker's Delight, transpose8)
+void st7558_transpose8(const uint8_t *in, uint8_t *out) {
+  uint32_t x, y, t;
+
+  x = ((uint32_t)in[7] << 24) | ((uint32_t)in[6] << 16) | (in[5] << 8) | in[4];
+  y = ((uint32_t)in[3] << 24) | ((uint32_t)in[2] << 16) | (in[1] << 8) | in[0];
+
+  t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+  t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+  y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+  x = t;
+
+  out[7] = x >> 24; out[6] = x >> 16; out[5] = x >> 8; out[4] = x;
+  out[3] = y >> 24; out[2] = y >> 16; out[1] = y >> 8; out[0] = y;
+}
+#endif
+
+void st7558_turnBlock(int16_t x, int16_t y, int16_t w, int16_t h,
+  int16_t bc, int16_t br, const uint8_t *block, uint8_t cw, uint8_t turns,
+  uint8_t *tile, int16_t *tx, int16_t *ty, int16_t *box) {
+
+  uint8_t s[8], t[8], i, rh;
+  int16_t px, py;
+
+  rh = (h - br < 8) ? h - br : 8;
+  for (i = 0; i < 8; i++)
+    s[i] = (i < cw) ? block[i] : 0;
+
+  // Tile origin, tile bytes and the part of the tile the image covers
+  switch (turns) {
+    case 1:
+      px = x + br;
+      py = y + w - 8 - bc;
+      st7558_transpose8(s, t);
+      for (i = 0; i < 8; i++) tile[i] = st7558_reverse8(t[i]);
+      box[0] = px;          box[2] = px + rh - 1;
+      box[1] = py + 8 - cw; box[3] = py + 7;
+      break;
+    case 2:
+      px = x + w - 8 - bc;
+      py = y + h - 8 - br;
+      for (i = 0; i < 8; i++) tile[i] = st7558_reverse8(s[7 - i]);
+      box[0] = px + 8 - cw; box[2] = px + 7;
+      box[1] = py + 8 - rh; box[3] = py + 7;
+      break;
+    default:
+      px = x + h - 8 - br;
+      py = y + bc;
+      st7558_transpose8(s, t);
+      for (i = 0; i < 8; i++) tile[i] = t[7 - i];
+      box[0] = px + 8 - rh; box[2] = px + 7;
+      box[1] = py;          box[3] = py + cw - 1;
+      break;
+  }
+  *tx = px;
+  *ty = py;
+}
+
+void st7558_blitTurnedBlock(uint8_t *dst, uint8_t stride,
+  int16_t x, int16_t y, int16_t w, int16_t h, int16_t bc, int16_t br,
+  const uint8_t *block, uint8_t cw,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  uint8_t rop, uint8_t turns) {
+
+  uint8_t tile[8];
+  int16_t px, py, v[4];
+
+  st7558_turnBlock(x, y, w, h, bc, br, block, cw, turns, tile, &px, &py, v);
+  if (v[0] < x0) v[0] = x0;
+  if (v[1] < y0) v[1] = y0;
+  if (v[2] > x1) v[2] = x1;
+  if (v[3] > y1) v[3] = y1;
+  st7558_blit(dst, stride, px, py, tile, 8, 8, v[0], v[1], v[2], v[3], rop, false);
+}
+
+void st7558_blitTurned(uint8_t *dst, uint8_t stride, int16_t x, int16_t y,
+  const uint8_t *src, int16_t w, int16_t h,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  uint8_t rop, boolean progmem, uint8_t turns) {
+
+  uint8_t block[8], cw, i;
+  int16_t bc, br;
+  const uint8_t *p;
+
+  for (br = 0; br < h; br += 8) {
+    for (bc = 0; bc < w; bc += 8) {
+      cw = (w - bc < 8) ? w - bc : 8;
+      p = src + (br >> 3) * w + bc;
+      for (i = 0; i < cw; i++)
+        block[i] = progmem ? pgm_read_byte(p + i) : p[i];
+      st7558_blitTurnedBlock(dst, stride, x, y, w, h, bc, br, block, cw,
+        x0, y0, x1, y1, rop, turns);
+    }
+  }
+}
@@ -0,0 +1,88 @@
+/***************************************************
+  Page-format bitmap blitter for the ST7558 library.
+
+  A page-format bitmap stores its pixels the way the controller does:
+  byte [page * w + x] holds rows page*8 .. page*8+7 of column x, LSB on
+  top, set bit = dark pixel. ST7558::getPixel(x, y, bitmap, w, h) reads
+  the same layout.
+
+  st7558_blit() works on any page-format destination (the framebuffer,
+  off-screen canvases), so the callers only deal with their own clipping
+  and dirty bookkeeping.
+ ****************************************************/
+
+#ifndef _ST7558_BLIT_H
+#define _ST7558_BLIT_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+  #include "Arduino.h"
+#else
+  #include "WProgram.h"
+#endif
+
+// Raster ops: how source bits combine with the destination
+#define ST7558_ROP_COPY    0   // dst = src
+#define ST7558_ROP_OR      1   // set the source's dark pixels
+#define ST7558_ROP_AND     2   // keep dark pixels only where the source has them
+#define ST7558_ROP_XOR     3   // invert under the source's dark pixels
+#define ST7558_ROP_ANDNOT  4   // clear the source's dark pixels
+
+// Combine source bits s into destination byte d, bits outside mask kept
+static inline uint8_t st7558_rop(uint8_t d, uint8_t s, uint8_t mask,
+  uint8_t rop) {
+  s &= mask;
+  switch (rop) {
+    case ST7558_ROP_OR:     return d | s;
+    case ST7558_ROP_AND:    return d & (s | ~mask);
+    case ST7558_ROP_XOR:    return d ^ s;
+    case ST7558_ROP_ANDNOT: return d & ~s;
+    default:                return (d & ~mask) | s;
+  }
+}
+
+// Blit a w x h page-format bitmap to (x, y) of a page-format destination
+// 'stride' bytes per page, clipped to the inclusive destination rectangle
+// x0,y0 - x1,y1. Any y works: source pages are shifted and merged into
+// whole destination bytes. 'progmem' says where the source lives.
+void st7558_blit(uint8_t *dst, uint8_t stride, int16_t x, int16_t y,
+  const uint8_t *src, int16_t w, int16_t h,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  uint8_t rop, boolean progmem);
+
+// Turned blits. 'turns' picks the mapping of the display rotation with
+// that number, for a w x h image whose turned bounding box has its top
+// left corner at (x, y):
+//   1  (c, r) -> (r, w-1-c)       2  (c, r) -> (w-1-c, h-1-r)
+//   3  (c, r) -> (h-1-r, c)
+// The image goes through in 8x8 blocks, each turned with a bit matrix
+// transpose and then blitted as above.
+void st7558_blitTurned(uint8_t *dst, uint8_t stride, int16_t x, int16_t y,
+  const uint8_t *src, int16_t w, int16_t h,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  uint8_t rop, boolean progmem, uint8_t turns);
+
+// One block of a turned blit: the 8 column bytes at column bc of page
+// br / 8 of the image, cw of them in use. For sources that stream.
+void st7558_blitTurnedBlock(uint8_t *dst, uint8_t stride,
+  int16_t x, int16_t y, int16_t w, int16_t h, int16_t bc, int16_t br,
+  const uint8_t *block, uint8_t cw,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  uint8_t rop, uint8_t turns);
+
+// The 8x8 tile block turns into: tile bytes, its top left corner at
+// (*tx, *ty) and the corners of the part the image covers in box
+void st7558_turnBlock(int16_t x, int16_t y, int16_t w, int16_t h,
+  int16_t bc, int16_t br, const uint8_t *block, uint8_t cw, uint8_t turns,
+  uint8_t *tile, int16_t *tx, int16_t *ty, int16_t *box);
+
+// out[i] bit j = in[j] bit i
+void st7558_transpose8(const uint8_t *in, uint8_t *out);
+
+// Bit order reversed
+static inline uint8_t st7558_reverse8(uint8_t b) {
+  b = (b >> 4) | (b << 4);
+  b = ((b >> 2) & 0x33) | ((b & 0x33) << 2);
+  return ((b >> 1) & 0x55) | ((b & 0x55) << 1);
+}
+
+#endif
@@ -0,0 +1,38 @@
+/***************************************************
+  Off-screen canvases for the ST7558 library.
+ ****************************************************/
+
+#include "ST7558_Canvas.h"
+
+ST7558_Canvas::ST7558_Canvas(uint8_t *bits, uint8_t w, uint8_t h)
+  : ST7558_Surface(w, h, bits, w), pooled(false)
+{
+  memset(bits, 0, ST7558_CANVAS_SIZE(w, h));
+}
+
+ST7558_Canvas::ST7558_Canvas(uint8_t w, uint8_t h)
+  : ST7558_Surface(w, h, (uint8_t *)st7558_alloc(ST7558_CANVAS_SIZE(w, h)), w),
+    pooled(true)
+{
+  if (bits)
+    memset(bits, 0, ST7558_CANVAS_SIZE(w, h));
+}
+
+ST7558_Canvas::~ST7558_Canvas() {
+  if (pooled)
+    st7558_free(bits);
+}
+
+uint8_t ST7558_Canvas::getPixel(int16_t x, int16_t y) {
+  x += origin_x;
+  y += origin_y;
+  if (!bits || (x < 0) || (x >= _width) || (y < 0) || (y >= _height))
+    return 0;
+  rotateXY(x, y);
+  return (bits[(y >> 3) * stride + x] >> (y & 7)) & 1;
+}
+
+void ST7558_Canvas::draw(ST7558 &lcd, int16_t x, int16_t y, uint8_t rop) {
+  if (bits)
+    lcd.drawPageBitmap(x, y, bits, WIDTH, HEIGHT, rop);
+}
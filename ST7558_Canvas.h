@@ -0,0 +1,50 @@
+/***************************************************
+  Off-screen canvases for the ST7558 library.
+
+  A canvas is a page-format bitmap (see ST7558_Blit.h) of any size with
+  the whole Core_GFX drawing API on it: origin, clip rectangle, rotation,
+  text. It is a drawing surface like the display (see ST7558_Surface.h),
+  so lines, fills, patterns, glyphs and region operations take the same
+  fast paths. Pre-render a widget, a graph or a block of text into one,
+  then draw() it onto the display as often as needed: that is a
+  byte-wise blit with a raster op, shifted to any y, instead of drawing
+  it all again.
+
+  The pixel buffer is ST7558_CANVAS_SIZE(w, h) bytes, from the caller or
+  from the library's pool (ST7558_Pool.h). A canvas the pool could not
+  serve has no buffer, draws nothing and returns NULL from getBuffer().
+  Colors and bit order are the display's: ST7558_BLACK sets a bit.
+ ****************************************************/
+
+#ifndef _ST7558_CANVAS_H
+#define _ST7558_CANVAS_H
+
+#include "ST7558.h"
+#include "ST7558_Pool.h"
+
+#define ST7558_CANVAS_SIZE(w, h) ((w) * (((h) + 7) / 8))
+
+class ST7558_Canvas : public ST7558_Surface {
+
+ public:
+  // w x h pixels in bits, or in a pool block, cleared to white
+  ST7558_Canvas(uint8_t *bits, uint8_t w, uint8_t h);
+  ST7558_Canvas(uint8_t w, uint8_t h);
+  ~ST7558_Canvas();
+
+  // The whole canvas, as the display shows it unrotated, at (x, y) of the
+  // display
+  void draw(ST7558 &lcd, int16_t x, int16_t y, uint8_t rop = ST7558_ROP_COPY);
+
+  uint8_t getPixel(int16_t x, int16_t y);
+  uint8_t *getBuffer(void) { return bits; }
+
+ private:
+  // A copy would free the same pool block twice
+  ST7558_Canvas(const ST7558_Canvas &);
+  ST7558_Canvas &operator=(const ST7558_Canvas &);
+
+  boolean pooled;
+};
+
+#endif
@@ -0,0 +1,149 @@
+/***************************************************
+  Strip charts for the ST7558 library.
+ ****************************************************/
+
+#include "ST7558_Chart.h"
+
+ST7558_Chart::ST7558_Chart(ST7558 &lcd, int16_t *samples,
+  int16_t x, int16_t y, int16_t w, int16_t h)
+  : lcd(lcd), samples(samples), x(x), y(y), w(w), h(h), count(0), head(0),
+    lo(0), hi(1), autoRange(true), gridX(0), gridY(0), tick(0), seq(0),
+    color(ST7558_BLACK), bg(ST7558_WHITE)
+{
+}
+
+void ST7558_Chart::setRange(int16_t low, int16_t high) {
+  if (low > high) swap(low, high);
+  if (low == high) {
+    if (high < 0x7FFF) high++; else low--;
+  }
+  lo = low;
+  hi = high;
+  autoRange = false;
+  redraw();
+}
+
+void ST7558_Chart::setAutoRange(void) {
+  autoRange = true;
+  rescale();
+  redraw();
+}
+
+void ST7558_Chart::setGrid(uint8_t gx, uint8_t gy) {
+  gridX = gx;
+  gridY = gy;
+  tick = 0;
+  redraw();
+}
+
+void ST7558_Chart::setColors(uint16_t c, uint16_t b) {
+  color = c;
+  bg = b;
+  redraw();
+}
+
+void ST7558_Chart::clear(void) {
+  count = head = 0;
+  redraw();
+}
+
+// The rest of the chart moves left under the clip rectangle, and the
+// column that comes into view at its right edge is drawn. The sample
+// the first column's line started from is gone, so that column is drawn
+// again without it.
+void ST7558_Chart::add(int16_t sample) {
+  int16_t old = samples[head], vx, vy, vw, vh;
+  boolean full = (count == w), scaled = false;
+
+  samples[head] = sample;
+  if (++head == w) head = 0;
+  if (!full) count++;
+  seq++;
+  if (gridX && (++tick == gridX)) tick = 0;
+
+  // The first sample sets the scale, whatever it is, and draws the chart
+  // whole. After that only a sample past the scale, or the end of one
+  // that set it, can change the scale.
+  if (autoRange && ((count == 1) || (sample < lo) || (sample > hi) ||
+      (full && ((old == lo) || (old == hi)))))
+    scaled = rescale();
+  if (scaled || (count == 1)) {
+    redraw();
+    return;
+  }
+
+  lcd.pushViewport(x, y, w, h);
+  lcd.getClipRect(vx, vy, vw, vh);
+  if (vw && vh) {
+    lcd.scrollRect(vx, vy, vw, vh, -1, 0);
+    drawColumn(vx + vw - 1);
+    if (!vx && (vw > 1))
+      drawColumn(0);
+  }
+  lcd.popViewport();
+}
+
+void ST7558_Chart::redraw(void) {
+  int16_t vx, vy, vw, vh, col;
+
+  lcd.pushViewport(x, y, w, h);
+  lcd.getClipRect(vx, vy, vw, vh);
+  if (vh)
+    for (col = vx; col < vx + vw; col++)
+      drawColumn(col);
+  lcd.popViewport();
+}
+
+// Lowest and highest sample shown, true if they moved. An empty chart
+// keeps its scale, a flat one gets a range of 1.
+boolean ST7558_Chart::rescale(void) {
+  int16_t low, high, i, v;
+
+  if (!count) return false;
+  low = high = samples[0];
+  for (i = 1; i < count; i++) {
+    v = samples[i];
+    if (v < low) low = v;
+    if (v > high) high = v;
+  }
+  if (low == high) {
+    if (high < 0x7FFF) high++; else low--;
+  }
+  if ((low == lo) && (high == hi)) return false;
+  lo = low;
+  hi = high;
+  return true;
+}
+
+// Sample in column col, which is w - 1 - col samples before the newest
+int16_t ST7558_Chart::sampleAt(int16_t col) const {
+  int16_t i = head - w + col;
+
+  return samples[(i < 0) ? i + w : i];
+}
+
+int16_t ST7558_Chart::rowOf(int16_t sample) const {
+  if (sample <= lo) return h - 1;
+  if (sample >= hi) return 0;
+  return h - 1 - ((int32_t)sample - lo) * (h - 1) / ((int32_t)hi - lo);
+}
+
+// One column in viewport coordinates: background, grid dots on every
+// other sample, and the line up or down from the previous sample
+void ST7558_Chart::drawColumn(int16_t col) {
+  int16_t back = w - 1 - col, r0, r1, r;
+  uint8_t n = seq - back;
+
+  lcd.drawFastVLine(col, 0, h, bg);
+  if (gridX && ((tick + gridX - back % gridX) % gridX == 0))
+    for (r = h - 1; r >= 0; r -= 2)
+      lcd.drawPixel(col, r, color);
+  if (gridY && !(n & 1))
+    for (r = h - 1; r >= 0; r -= gridY)
+      lcd.drawPixel(col, r, color);
+  if (back >= count) return;
+  r1 = rowOf(sampleAt(col));
+  r0 = (col && (back + 1 < count)) ? rowOf(sampleAt(col - 1)) : r1;
+  if (r0 > r1) swap(r0, r1);
+  lcd.drawFastVLine(col, r0, r1 - r0 + 1, color);
+}
@@ -0,0 +1,62 @@
+/***************************************************
+  Strip charts for the ST7558 library.
+
+  A chart plots the last w samples of a value in a w x h area of the
+  display, one column per sample, newest on the right. The samples live
+  in a ring buffer of w int16_t the caller provides.
+
+  add() moves the chart left a column with scrollRect(), a page row of
+  bytes at a time, and draws just the column that comes into view: the
+  line from the previous sample to the new one, over an optional dotted
+  grid. Horizontal grid lines are every gridY pixels up from the bottom,
+  vertical ones every gridX samples, and they scroll with the data.
+
+  With setRange() the scale is fixed and samples outside it are drawn
+  at the edge. Without it the chart scales itself to the samples it
+  shows, and redraws whole only when their lowest or highest value
+  changes. The set*() calls and clear() redraw the chart. After drawing
+  over it, or moving it with the origin, clip rectangle or rotation,
+  call redraw().
+ ****************************************************/
+
+#ifndef _ST7558_CHART_H
+#define _ST7558_CHART_H
+
+#include "ST7558.h"
+
+class ST7558_Chart {
+
+ public:
+  ST7558_Chart(ST7558 &lcd, int16_t *samples,
+    int16_t x, int16_t y, int16_t w, int16_t h);
+
+  void setRange(int16_t lo, int16_t hi),   // fixed scale
+    setAutoRange(void),                    // scale to the samples shown
+    setGrid(uint8_t gridX, uint8_t gridY), // 0: no lines that way
+    setColors(uint16_t color, uint16_t bg),
+    add(int16_t sample),
+    clear(void),                           // forget the samples
+    redraw(void);
+
+  int16_t getLow(void) const { return lo; }
+  int16_t getHigh(void) const { return hi; }
+
+ private:
+  boolean rescale(void);
+  int16_t sampleAt(int16_t col) const,
+    rowOf(int16_t sample) const;
+  void drawColumn(int16_t col);
+
+  ST7558 &lcd;
+  int16_t *samples;
+  int16_t x, y, w, h;
+  int16_t count, head;                     // head: where the next one goes
+  int16_t lo, hi;
+  boolean autoRange;
+  uint8_t gridX, gridY,
+    tick,                                  // newest sample's place in gridX
+    seq;                                   // newest sample's number, mod 256
+  uint16_t color, bg;
+};
+
+#endif
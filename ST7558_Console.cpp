@@ -0,0 +1,138 @@
+/***************************************************
+  Text console for the ST7558 library.
+ ****************************************************/
+
+#include "ST7558_Console.h"
+
+ST7558_Console::ST7558_Console(ST7558 &lcd)
+  : lcd(lcd), col(0), row(0), top(0), bottom(ST7558_CONSOLE_ROWS - 1),
+    invert(0), utf8state(0), utf8codepoint(0)
+{
+  memset(dirty, 0, sizeof(dirty));
+}
+
+void ST7558_Console::clear(void) {
+  uint8_t r;
+
+  for (r = 0; r < ST7558_CONSOLE_ROWS; r++)
+    blank(r);
+  col = row = 0;
+}
+
+void ST7558_Console::clearLine(void) {
+  blank(row);
+  col = 0;
+}
+
+void ST7558_Console::setCursor(uint8_t c, uint8_t r) {
+  col = min(c, ST7558_CONSOLE_COLS - 1);
+  row = min(r, ST7558_CONSOLE_ROWS - 1);
+}
+
+// An empty or out of range region is the whole screen
+void ST7558_Console::setScrollRegion(uint8_t t, uint8_t b) {
+  if ((t > b) || (b >= ST7558_CONSOLE_ROWS)) {
+    t = 0;
+    b = ST7558_CONSOLE_ROWS - 1;
+  }
+  top = t;
+  bottom = b;
+  col = 0;
+  row = top;
+}
+
+void ST7558_Console::setInverse(boolean on) {
+  invert = on ? 0xFF : 0x00;
+}
+
+#if ARDUINO >= 100
+size_t ST7558_Console::write(uint8_t c) {
+#else
+void ST7558_Console::write(uint8_t c) {
+#endif
+  uint16_t cp, glyph;
+
+  if (!Core_GFX::decodeUTF8(c, utf8state, utf8codepoint, cp)) {
+    // Code point still incomplete
+  } else if (cp == '\n') {
+    newLine();
+  } else if (cp == '\r') {
+    col = 0;
+  } else if ((glyph = lcd.glyphIndex(cp)) != GFX_NO_GLYPH) {
+    putGlyph(glyph);
+  }
+#if ARDUINO >= 100
+  return 1;
+#endif
+}
+
+// Text wraps when a glyph is due past the last column, so a full row
+// followed by '\n' takes one line, not two
+void ST7558_Console::putGlyph(uint16_t glyph) {
+  const uint8_t *bitmap = lcd.getFont()->bitmap + glyph * GFX_GLYPH_WIDTH;
+  uint8_t *p, i, b;
+
+  if (col >= ST7558_CONSOLE_COLS) newLine();
+  p = &st7558_buffer[row][col * ST7558_CONSOLE_CELL];
+  for (i = 0; i < ST7558_CONSOLE_CELL; i++) {
+    b = (i < GFX_GLYPH_WIDTH) ? pgm_read_byte(bitmap + i) ^ invert : invert;
+    if (p[i] != b) {
+      p[i] = b;
+      dirty[row] |= 1 << col;
+    }
+  }
+  col++;
+}
+
+void ST7558_Console::newLine(void) {
+  col = 0;
+  if (row == bottom)
+    scroll();
+  else if (row < ST7558_CONSOLE_ROWS - 1)
+    row++;
+}
+
+// A cell that already shows what moves into it stays clean
+void ST7558_Console::scroll(void) {
+  uint8_t r, c, x;
+
+  for (r = top; r < bottom; r++)
+    for (c = 0, x = 0; c < ST7558_CONSOLE_COLS; c++, x += ST7558_CONSOLE_CELL)
+      if (memcmp(&st7558_buffer[r][x], &st7558_buffer[r + 1][x],
+          ST7558_CONSOLE_CELL))
+        dirty[r] |= 1 << c;
+  memmove(st7558_buffer[top], st7558_buffer[top + 1],
+    (bottom - top) * sizeof(st7558_buffer[0]));
+  blank(bottom);
+}
+
+// A row of cells in the background of the current colors
+void ST7558_Console::blank(uint8_t r) {
+  uint8_t c, i, *p;
+
+  for (c = 0; c < ST7558_CONSOLE_COLS; c++) {
+    p = &st7558_buffer[r][c * ST7558_CONSOLE_CELL];
+    for (i = 0; i < ST7558_CONSOLE_CELL; i++) {
+      if (p[i] != invert) {
+        p[i] = invert;
+        dirty[r] |= 1 << c;
+      }
+    }
+  }
+}
+
+// One displaySpan() per run of changed cells
+void ST7558_Console::flush(void) {
+  uint8_t r, c, n;
+  uint16_t m;
+
+  for (r = 0; r < ST7558_CONSOLE_ROWS; r++) {
+    m = dirty[r];
+    for (c = 0; m; c += n) {
+      for (; !(m & 1); m >>= 1) c++;
+      for (n = 0; m & 1; m >>= 1) n++;
+      lcd.displaySpan(r, c * ST7558_CONSOLE_CELL, n * ST7558_CONSOLE_CELL);
+    }
+    dirty[r] = 0;
+  }
+}
@@ -0,0 +1,70 @@
+/***************************************************
+  Text console for the ST7558 library.
+
+  The display as a grid of ST7558_CONSOLE_COLS x ST7558_CONSOLE_ROWS
+  character cells, 6x8 pixels each, in the controller's own orientation.
+  A cell row is exactly one page, so a glyph goes into the framebuffer as
+  6 byte copies (5 font columns and a blank one) and scrolling a row up
+  is a memmove() of whole pages.
+
+  Printing marks the cells it changes, a bit per cell, and flush() sends
+  runs of marked cells with displaySpan(), leaving the rest of the
+  display alone. A scroll compares each cell with the one moving into it
+  and marks only those that differ, so blank margins and repeated
+  columns cost nothing to send. Text scrolls inside the rows of the
+  scroll region; rows outside it stay put, for titles and status lines.
+
+  The console writes into the framebuffer directly, not through the
+  drawing clip rectangle or rotation, and the display's own flush() does
+  not see it. Send it with the console's flush() or with display().
+ ****************************************************/
+
+#ifndef _ST7558_CONSOLE_H
+#define _ST7558_CONSOLE_H
+
+#include "ST7558.h"
+
+#define ST7558_CONSOLE_COLS (ST7558_MAX_TEXT_ROW + 1)    // 16 cells per row
+#define ST7558_CONSOLE_ROWS (ST7558_MAX_TEXT_LINE + 1)   // 8 rows, a page each
+#define ST7558_CONSOLE_CELL 6                            // pixels per cell
+
+class ST7558_Console : public Print {
+
+ public:
+  ST7558_Console(ST7558 &lcd);
+
+  void
+    clear(void),                          // blank cells, cursor home
+    clearLine(void),                      // blank the cursor's row
+    setCursor(uint8_t col, uint8_t row),
+    setScrollRegion(uint8_t top, uint8_t bottom),   // rows, inclusive
+    setInverse(boolean on),               // light text on dark cells
+    scroll(void),                         // scroll region up a row
+    flush(void);                          // send the cells that changed
+
+  uint8_t getCol(void) const { return col; }
+  uint8_t getRow(void) const { return row; }
+
+  // UTF-8, like Core_GFX::write(). '\n' starts a new line, scrolling at
+  // the bottom of the scroll region, '\r' goes back to column 0
+#if ARDUINO >= 100
+  virtual size_t write(uint8_t c);
+#else
+  virtual void   write(uint8_t c);
+#endif
+  using Print::write;
+
+ private:
+  void putGlyph(uint16_t glyph),
+    newLine(void),
+    blank(uint8_t row);
+
+  ST7558 &lcd;
+  uint16_t dirty[ST7558_CONSOLE_ROWS];    // bit n: cell n changed
+  uint8_t col, row, top, bottom,
+    invert,                               // 0xFF for inverse text
+    utf8state;                            // continuation bytes expected
+  uint16_t utf8codepoint;
+};
+
+#endif
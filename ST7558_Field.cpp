@@ -0,0 +1,106 @@
+/***************************************************
+  Text and number fields for the ST7558 library.
+ ****************************************************/
+
+#include "ST7558_Field.h"
+
+ST7558_Field::ST7558_Field(ST7558 &lcd, int16_t x, int16_t y, uint8_t chars,
+  uint8_t align, uint8_t size)
+  : lcd(lcd), x(x), y(y), chars(min(chars, ST7558_FIELD_CHARS)),
+    align(align), size(size ? size : 1),
+    color(ST7558_BLACK), bg(ST7558_WHITE), changed0(1), changed1(0)
+{
+  invalidate();
+}
+
+void ST7558_Field::setColors(uint16_t c, uint16_t b) {
+  if ((c == color) && (b == bg)) return;
+  color = c;
+  bg = b;
+  invalidate();
+}
+
+void ST7558_Field::invalidate(void) {
+  memset(shown, 0, sizeof(shown));
+}
+
+void ST7558_Field::setText(const char *text) {
+  show(text, strlen(text));
+}
+
+// Digits are produced from the right, into the end of a buffer as wide
+// as the widest field
+void ST7558_Field::setNumber(int32_t value, uint8_t decimals) {
+  char buf[ST7558_FIELD_CHARS], *p = buf + sizeof(buf);
+  uint32_t n = (value < 0) ? -(uint32_t)value : value;
+  uint8_t digits = 0, point = decimals;
+
+  do {
+    if (p == buf) {
+      show(NULL, 0);                      // does not fit
+      return;
+    }
+    if (point && (digits == point)) {
+      *--p = '.';
+      point = 0;
+      continue;
+    }
+    *--p = '0' + n % 10;
+    n /= 10;
+    digits++;
+  } while (n || (digits <= decimals));    // "0.05", not ".05"
+  if (value < 0) {
+    if (p == buf) {
+      show(NULL, 0);
+      return;
+    }
+    *--p = '-';
+  }
+  show(p, buf + sizeof(buf) - p);
+}
+
+// Only cells whose character differs from the one drawn there are drawn.
+// NULL text, or more than fits, fills the field with '#'.
+void ST7558_Field::show(const char *text, size_t len) {
+  uint8_t i, lead = 0, w = 6 * size;
+  uint16_t glyph;
+  char c;
+
+  if (len > chars)
+    text = NULL;
+  else if (align == ST7558_FIELD_RIGHT)
+    lead = chars - len;
+
+  changed0 = 1;
+  changed1 = 0;
+  for (i = 0; i < chars; i++) {
+    if (!text)
+      c = '#';
+    else if ((i < lead) || (i >= lead + len))
+      c = ' ';
+    else
+      c = text[i - lead];
+    if (c == shown[i]) continue;
+    shown[i] = c;
+    glyph = lcd.glyphIndex((uint8_t)c);
+    if (glyph == GFX_NO_GLYPH) {
+      lcd.fillRect(x + i * w, y, w, 8 * size, bg);
+    } else {
+      lcd.drawGlyph(x + i * w, y, glyph, color, bg, size);
+      lcd.fillRect(x + i * w + GFX_GLYPH_WIDTH * size, y, size, 8 * size, bg);
+    }
+    if (changed0 > changed1) changed0 = i;
+    changed1 = i;
+  }
+}
+
+boolean ST7558_Field::getChanged(int16_t &cx, int16_t &cy, int16_t &cw,
+  int16_t &ch) const {
+
+  if (changed0 > changed1) return false;
+  cx = x + changed0 * 6 * size;
+  cy = y;
+  cw = (changed1 - changed0 + 1) * 6 * size;
+  ch = 8 * size;
+  return true;
+}
@@ -0,0 +1,56 @@
+/***************************************************
+  Text and number fields for the ST7558 library.
+
+  A field is a fixed number of character cells at a spot on the display,
+  6x8 pixels each at text size 1. It remembers the text it last drew,
+  and setText() or setNumber() draws only the cells whose character
+  changed, each as one opaque glyph, so a reading that goes from 1234
+  to 1235 costs one glyph and the display's flush() sends 6 columns.
+  getChanged() gives the rectangle that last update drew, for callers
+  that send or track areas themselves.
+
+  setNumber() formats a fixed point integer (value 1234 with 2 decimals
+  is "12.34") without the float code of Print. Text longer than the
+  field, and numbers too wide for it, show as a row of '#'.
+
+  Fields draw through the display's primitives, in logical coordinates
+  and inside its clip rectangle. After drawing over a field, or clearing
+  the display, invalidate() it.
+ ****************************************************/
+
+#ifndef _ST7558_FIELD_H
+#define _ST7558_FIELD_H
+
+#include "ST7558.h"
+
+#define ST7558_FIELD_CHARS 12   // widest field, in cells
+
+#define ST7558_FIELD_LEFT  0    // alignment
+#define ST7558_FIELD_RIGHT 1
+
+class ST7558_Field {
+
+ public:
+  ST7558_Field(ST7558 &lcd, int16_t x, int16_t y, uint8_t chars,
+    uint8_t align = ST7558_FIELD_RIGHT, uint8_t size = 1);
+
+  void setColors(uint16_t color, uint16_t bg),
+    setText(const char *text),            // one byte per cell
+    setNumber(int32_t value, uint8_t decimals = 0),
+    invalidate(void);                     // next set*() draws every cell
+
+  // Area the last set*() drew, false if it drew nothing
+  boolean getChanged(int16_t &x, int16_t &y, int16_t &w, int16_t &h) const;
+
+ private:
+  void show(const char *text, size_t len);
+
+  ST7558 &lcd;
+  int16_t x, y;
+  uint8_t chars, align, size;
+  uint16_t color, bg;
+  char shown[ST7558_FIELD_CHARS];         // 0: cell needs drawing
+  uint8_t changed0, changed1;             // cells, changed0 > changed1: none
+};
+
+#endif
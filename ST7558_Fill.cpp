@@ -0,0 +1,192 @@
+/***************************************************
+  Flood fill on page-format buffers for the ST7558 library.
+ ****************************************************/
+
+#include "ST7558_Fill.h"
+
+// A run in column x, rows y0..y1, to scan for pixels still to fill. The
+// run that queued it lies in column x - dir, rows y0..y1 exactly.
+struct Span {
+  uint8_t x, y0, y1;
+  int8_t dir;
+};
+
+struct Area {
+  uint8_t *buf, stride, color;
+  int16_t x0, y0, x1, y1;
+};
+
+// Pixels of the area's color among the 8 of one column in page 'page'
+static inline uint8_t match(const Area &a, const uint8_t *col, uint8_t page) {
+  uint8_t b = col[page * a.stride];
+
+  return a.color ? b : (uint8_t)~b;
+}
+
+static inline uint8_t lowBit(uint8_t m) {
+  uint8_t n = 0;
+
+  for (; !(m & 0x01); m >>= 1) n++;
+  return n;
+}
+
+static inline uint8_t highBit(uint8_t m) {
+  uint8_t n = 7;
+
+  for (; !(m & 0x80); m <<= 1) n--;
+  return n;
+}
+
+// First row from y to yEnd in the area's color, -1 if none. Pages with
+// none of it are passed over whole.
+static int16_t firstMatch(const Area &a, const uint8_t *col, int16_t y,
+  int16_t yEnd) {
+
+  uint8_t page, m;
+
+  if (y > yEnd) return -1;
+  page = y >> 3;
+  m = match(a, col, page) & (0xFF << (y & 7));
+  while (!m) {
+    if (++page > (yEnd >> 3)) return -1;
+    m = match(a, col, page);
+  }
+  y = page * 8 + lowBit(m);
+  return (y <= yEnd) ? y : -1;
+}
+
+// Ends of the run through row y, which is in the area's color
+static int16_t runEnd(const Area &a, const uint8_t *col, int16_t y) {
+  uint8_t page = y >> 3, m = ~match(a, col, page) & (0xFF << (y & 7));
+
+  while (!m) {
+    if (page == (a.y1 >> 3)) return a.y1;
+    m = ~match(a, col, ++page);
+  }
+  y = page * 8 + lowBit(m) - 1;
+  return min(y, a.y1);
+}
+
+static int16_t runStart(const Area &a, const uint8_t *col, int16_t y) {
+  uint8_t page = y >> 3, m = ~match(a, col, page) & (0xFF >> (7 - (y & 7)));
+
+  while (!m) {
+    if (page == (a.y0 >> 3)) return a.y0;
+    m = ~match(a, col, --page);
+  }
+  y = page * 8 + highBit(m) + 1;
+  return max(y, a.y0);
+}
+
+// Masked bytes on the edge pages, plain stores in between
+static void fillRun(const Area &a, uint8_t *col, int16_t y0, int16_t y1) {
+  uint8_t page = y0 >> 3, lastPage = y1 >> 3, mask = 0xFF << (y0 & 7), *p;
+
+  for (;;) {
+    if (page == lastPage)
+      mask &= 0xFF >> (7 - (y1 & 7));
+    p = col + page * a.stride;
+    *p = a.color ? (*p & ~mask) : (*p | mask);
+    if (page == lastPage) break;
+    page++;
+    mask = 0xFF;
+  }
+}
+
+static inline void push(const Area &a, Span *stack, uint8_t &sp,
+  int16_t x, int16_t y0, int16_t y1, int8_t dir) {
+
+  if ((x < a.x0) || (x > a.x1)) return;
+  stack[sp].x = x;
+  stack[sp].y0 = y0;
+  stack[sp].y1 = y1;
+  stack[sp].dir = dir;
+  sp++;
+}
+
+static inline void grow(int16_t *box, int16_t x, int16_t y0, int16_t y1) {
+  if (!box) return;
+  if (box[0] > box[2]) {
+    box[0] = box[2] = x;
+    box[1] = y0;
+    box[3] = y1;
+    return;
+  }
+  if (x < box[0]) box[0] = x;
+  if (x > box[2]) box[2] = x;
+  if (y0 < box[1]) box[1] = y0;
+  if (y1 > box[3]) box[3] = y1;
+}
+
+// Each run found is filled and queues its neighbours: the next column
+// on, and back where it reaches past the run that queued it (Heckbert's
+// seed fill, turned on its side). Filled pixels no longer match, so no
+// run is found twice.
+boolean st7558_floodFill(uint8_t *buf, uint8_t stride, int16_t x, int16_t y,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1, boolean dark, int16_t *box) {
+
+  Span stack[ST7558_FILL_STACK], s;
+  struct {
+    uint8_t x, y;
+  } restart[ST7558_FILL_RESTARTS];
+  uint8_t sp = 0, rp = 0, *col;
+  int16_t r0, r1;
+  boolean complete = true;
+  Area a;
+
+  if (box) {
+    box[0] = box[1] = 0;
+    box[2] = box[3] = -1;
+  }
+  if ((x < x0) || (x > x1) || (y < y0) || (y > y1)) return true;
+  a.buf = buf;
+  a.stride = stride;
+  a.x0 = x0;
+  a.y0 = y0;
+  a.x1 = x1;
+  a.y1 = y1;
+  a.color = (buf[(y >> 3) * stride + x] >> (y & 7)) & 1;
+  if (a.color == (dark ? 1 : 0)) return true;
+
+  restart[rp].x = x;
+  restart[rp].y = y;
+  rp++;
+  while (rp) {
+    rp--;
+    x = restart[rp].x;
+    y = restart[rp].y;
+    col = buf + x;
+    if (!((match(a, col, y >> 3) >> (y & 7)) & 1)) continue;   // done since
+    r0 = runStart(a, col, y);
+    r1 = runEnd(a, col, y);
+    fillRun(a, col, r0, r1);
+    grow(box, x, r0, r1);
+    push(a, stack, sp, x + 1, r0, r1, 1);
+    push(a, stack, sp, x - 1, r0, r1, -1);
+
+    while (sp) {
+      s = stack[--sp];
+      col = buf + s.x;
+      for (y = s.y0; (y = firstMatch(a, col, y, s.y1)) >= 0; y = r1 + 2) {
+        r0 = runStart(a, col, y);
+        r1 = runEnd(a, col, y);
+        if (sp > ST7558_FILL_STACK - 3) {   // no room for what it queues
+          if (rp < ST7558_FILL_RESTARTS) {
+            restart[rp].x = s.x;
+            restart[rp].y = r0;
+            rp++;
+          } else {
+            complete = false;
+          }
+          continue;
+        }
+        fillRun(a, col, r0, r1);
+        grow(box, s.x, r0, r1);
+        push(a, stack, sp, s.x + s.dir, r0, r1, s.dir);
+        if (r0 < s.y0 - 1) push(a, stack, sp, s.x - s.dir, r0, s.y0 - 2, -s.dir);
+        if (r1 > s.y1 + 1) push(a, stack, sp, s.x - s.dir, s.y1 + 2, r1, -s.dir);
+      }
+    }
+  }
+  return complete;
+}
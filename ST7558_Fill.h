@@ -0,0 +1,39 @@
+/***************************************************
+  Flood fill on page-format buffers for the ST7558 library.
+
+  A scanline fill whose scanlines are columns: a page byte holds 8
+  pixels of one column, so runs are found and filled a byte at a time
+  with page masks. Pending runs wait on a span stack of
+  ST7558_FILL_STACK entries (4 bytes each) on the C stack, never more.
+
+  When that stack is full, a run is left unfilled and one of its pixels
+  is parked as a restart point instead (ST7558_FILL_RESTARTS of them, 2
+  bytes each). Once the stack has drained, each parked pixel still in
+  the area's color is filled from again with an empty stack, which picks
+  up everything that hung off the skipped runs. Only when the restart
+  points run out too is part of the area left, and the fill returns
+  false. It never spills outside the area: a one bit buffer cannot tell
+  filled pixels from an outline of the same color, so there is no image
+  rescan that would be safe.
+
+  ST7558 and ST7558_Canvas wrap it as floodFill(x, y, color), in logical
+  coordinates and inside their clip rectangles.
+ ****************************************************/
+
+#ifndef _ST7558_FILL_H
+#define _ST7558_FILL_H
+
+#include "ST7558_Blit.h"
+
+#define ST7558_FILL_STACK    32   // pending runs
+#define ST7558_FILL_RESTARTS 8    // parked pixels, when the stack is full
+
+// Fill the 4-connected area of pixels colored like (x, y) with dark or
+// light pixels, never leaving x0,y0 - x1,y1 (corners inclusive, inside
+// the buffer). If box is not NULL it gets the corners of what changed,
+// box[0] > box[2] when nothing did. Returns false if part of the area
+// was left unfilled.
+boolean st7558_floodFill(uint8_t *buf, uint8_t stride, int16_t x, int16_t y,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1, boolean dark, int16_t *box);
+
+#endif
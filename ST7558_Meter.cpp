@@ -0,0 +1,141 @@
+/***************************************************
+  Bars and needle gauges for the ST7558 library.
+ ****************************************************/
+
+#include "ST7558_Meter.h"
+
+ST7558_Bar::ST7558_Bar(ST7558 &lcd, int16_t x, int16_t y, int16_t w,
+  int16_t h, uint8_t flags)
+  : lcd(lcd), x(x), y(y), w(w), h(h), flags(flags), lo(0), hi(100),
+    value(0), shown(-1), color(ST7558_BLACK), bg(ST7558_WHITE)
+{
+  if (flags & ST7558_METER_FRAME) {
+    this->x += 2;
+    this->y += 2;
+    this->w = max(w - 4, 0);
+    this->h = max(h - 4, 0);
+  }
+}
+
+void ST7558_Bar::setRange(int16_t low, int16_t high) {
+  if (low > high) swap(low, high);
+  lo = low;
+  hi = high;
+  setValue(value);
+}
+
+void ST7558_Bar::setColors(uint16_t c, uint16_t b) {
+  color = c;
+  bg = b;
+  if (shown >= 0) draw();
+}
+
+// Only the part between the old and the new length is drawn
+void ST7558_Bar::setValue(int16_t v) {
+  int16_t n;
+
+  value = min(max(v, lo), hi);
+  if (shown < 0) return;
+  n = length();
+  if (n > shown)
+    span(shown, n, color);
+  else if (n < shown)
+    span(n, shown, bg);
+  shown = n;
+}
+
+void ST7558_Bar::draw(void) {
+  int16_t n = length();
+
+  if (flags & ST7558_METER_FRAME) {
+    lcd.drawRect(x - 2, y - 2, w + 4, h + 4, color);
+    lcd.drawRect(x - 1, y - 1, w + 2, h + 2, bg);
+  }
+  span(0, n, color);
+  span(n, (flags & ST7558_METER_VERTICAL) ? h : w, bg);
+  shown = n;
+}
+
+int16_t ST7558_Bar::length(void) const {
+  int16_t len = (flags & ST7558_METER_VERTICAL) ? h : w;
+
+  if (hi == lo) return 0;
+  return ((int32_t)value - lo) * len / ((int32_t)hi - lo);
+}
+
+// Pixels from..to - 1 along the bar, from the left or the bottom
+void ST7558_Bar::span(int16_t from, int16_t to, uint16_t c) {
+  if (to <= from) return;
+  if (flags & ST7558_METER_VERTICAL)
+    lcd.fillRect(x, y + h - to, w, to - from, c);
+  else
+    lcd.fillRect(x + from, y, to - from, h, c);
+}
+
+ST7558_Gauge::ST7558_Gauge(ST7558 &lcd, int16_t cx, int16_t cy, int16_t r,
+  uint8_t start, int16_t sweep)
+  : lcd(lcd), cx(cx), cy(cy), r(r), start(start), sweep(sweep), ticks(0),
+    lo(0), hi(100), value(0), shown(0), drawn(false),
+    color(ST7558_BLACK), bg(ST7558_WHITE)
+{
+}
+
+void ST7558_Gauge::setRange(int16_t low, int16_t high) {
+  if (low > high) swap(low, high);
+  lo = low;
+  hi = high;
+  setValue(value);
+}
+
+void ST7558_Gauge::setTicks(uint8_t t) {
+  ticks = t;
+  if (drawn) draw();
+}
+
+void ST7558_Gauge::setColors(uint16_t c, uint16_t b) {
+  color = c;
+  bg = b;
+  if (drawn) draw();
+}
+
+// The old needle is erased and the new one drawn, unless it has not
+// turned far enough to move
+void ST7558_Gauge::setValue(int16_t v) {
+  uint8_t a;
+
+  value = min(max(v, lo), hi);
+  if (!drawn) return;
+  a = angle(value);
+  if (a == shown) return;
+  needle(shown, bg);
+  needle(a, color);
+  shown = a;
+}
+
+void ST7558_Gauge::draw(void) {
+  uint16_t i;
+
+  if (drawn) needle(shown, bg);
+  for (i = 0; ticks && (i <= ticks); i++)
+    ray(start + (int32_t)sweep * i / ticks, r + 2, r + 4, color);
+  shown = angle(value);
+  needle(shown, color);
+  drawn = true;
+}
+
+uint8_t ST7558_Gauge::angle(int16_t v) const {
+  if (hi == lo) return start;
+  return start + (int32_t)sweep * ((int32_t)v - lo) / ((int32_t)hi - lo);
+}
+
+void ST7558_Gauge::needle(uint8_t a, uint16_t c) {
+  ray(a, 0, r, c);
+}
+
+// Line along angle a from radius r0 to r1, y up
+void ST7558_Gauge::ray(uint8_t a, int16_t r0, int16_t r1, uint16_t c) {
+  int32_t cs = gfxCos(a), sn = gfxSin(a);
+
+  lcd.drawLine(cx + ((r0 * cs + 16384) >> 15), cy - ((r0 * sn + 16384) >> 15),
+    cx + ((r1 * cs + 16384) >> 15), cy - ((r1 * sn + 16384) >> 15), c);
+}
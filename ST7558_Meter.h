@@ -0,0 +1,87 @@
+/***************************************************
+  Bars and needle gauges for the ST7558 library.
+
+  Both keep what they last drew and draw only the difference on the
+  next setValue(). A bar fills or clears just the part between its old
+  and new length. A gauge erases the old needle and draws the new one,
+  and does nothing while the needle stays on the same angle. All drawing
+  goes through the display's primitives, so flush() sends only the
+  columns that changed, and a screen of meters costs in proportion to
+  how far their values move.
+
+  A bar is a progress bar or a level meter: w x h pixels, filled from
+  the left, or from the bottom with ST7558_METER_VERTICAL, optionally
+  inside a frame. A gauge's needle turns about (cx, cy) from angle
+  'start' through 'sweep', angles being 0..255 for a full turn as in
+  Core_GFX_3D.h, counterclockwise and 0 pointing right. A negative
+  sweep turns clockwise. Its ticks lie just outside the needle's reach.
+
+  Values are clamped to the range. draw() draws a meter whole: call it
+  first, and again after drawing over it or clearing the display.
+ ****************************************************/
+
+#ifndef _ST7558_METER_H
+#define _ST7558_METER_H
+
+#include "ST7558.h"
+#include <Core_GFX_3D.h>
+
+#define ST7558_METER_VERTICAL 0x01   // bar fills from the bottom
+#define ST7558_METER_FRAME    0x02   // bar has a frame and a 1 pixel gap
+
+class ST7558_Bar {
+
+ public:
+  ST7558_Bar(ST7558 &lcd, int16_t x, int16_t y, int16_t w, int16_t h,
+    uint8_t flags = ST7558_METER_FRAME);
+
+  void setRange(int16_t lo, int16_t hi),
+    setColors(uint16_t color, uint16_t bg),
+    setValue(int16_t value),
+    draw(void);
+
+  int16_t getValue(void) const { return value; }
+
+ private:
+  int16_t length(void) const;
+  void span(int16_t from, int16_t to, uint16_t c);
+
+  ST7558 &lcd;
+  int16_t x, y, w, h;          // the fill area, inside any frame
+  uint8_t flags;
+  int16_t lo, hi, value,
+    shown;                     // filled pixels on the display, -1: none yet
+  uint16_t color, bg;
+};
+
+class ST7558_Gauge {
+
+ public:
+  ST7558_Gauge(ST7558 &lcd, int16_t cx, int16_t cy, int16_t r,
+    uint8_t start, int16_t sweep);
+
+  void setRange(int16_t lo, int16_t hi),
+    setTicks(uint8_t ticks),   // marks at both ends and ticks - 1 between
+    setColors(uint16_t color, uint16_t bg),
+    setValue(int16_t value),
+    draw(void);
+
+  int16_t getValue(void) const { return value; }
+
+ private:
+  uint8_t angle(int16_t v) const;
+  void needle(uint8_t a, uint16_t c),
+    ray(uint8_t a, int16_t r0, int16_t r1, uint16_t c);
+
+  ST7558 &lcd;
+  int16_t cx, cy, r;
+  uint8_t start;
+  int16_t sweep;
+  uint8_t ticks;
+  int16_t lo, hi, value;
+  uint8_t shown;               // needle angle on the display
+  boolean drawn;
+  uint16_t color, bg;
+};
+
+#endif
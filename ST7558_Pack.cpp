@@ -0,0 +1,59 @@
+/***************************************************
+  Packed (run length coded) page-format bitmaps for the ST7558 library.
+ ****************************************************/
+
+#include "ST7558_Pack.h"
+#include "ST7558_Blit.h"
+
+// Rows of page p inside y0..y1
+static uint8_t rowMask(int16_t p, int16_t y0, int16_t y1) {
+  int16_t lo = max(y0, p * 8), hi = min(y1, p * 8 + 7);
+
+  if (lo > hi) return 0;
+  return (0xFF << (lo & 7)) & (0xFF >> (7 - (hi & 7)));
+}
+
+void st7558_unpack(uint8_t *dst, uint8_t stride, int16_t x, int16_t y,
+  const uint8_t *packed, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  uint8_t rop) {
+
+  ST7558_Unpacker u(packed);
+  int16_t w = pgm_read_byte(packed), h = pgm_read_byte(packed + 1);
+  int16_t q, pages, r0, pd, s, c, first, last;
+  uint8_t rows, loMask, hiMask, b, *lo, *hi;
+
+  if (x0 < x) x0 = x;
+  if (y0 < y) y0 = y;
+  if (x1 > x + w - 1) x1 = x + w - 1;
+  if (y1 > y + h - 1) y1 = y + h - 1;
+  if ((x0 > x1) || (y0 > y1)) return;
+
+  first = x0 - x;
+  last = x1 - x;
+  pages = (h + 7) >> 3;
+  for (q = 0; q < pages; q++) {
+    r0 = y + q * 8;
+    if (r0 > y1) break;                 // the rest is clipped away
+    if (r0 + 7 < y0) {
+      u.skip(w);
+      continue;
+    }
+
+    // Source page q lands s rows into destination page pd
+    pd = (r0 >= 0) ? (r0 >> 3) : -((7 - r0) >> 3);
+    s = r0 - pd * 8;
+    rows = (q == pages - 1) ? 0xFF >> (7 - ((h - 1) & 7)) : 0xFF;
+    loMask = (rows << s) & rowMask(pd, y0, y1);
+    hiMask = s ? (rows >> (8 - s)) & rowMask(pd + 1, y0, y1) : 0;
+    lo = loMask ? dst + pd * stride + x0 : NULL;
+    hi = hiMask ? dst + (pd + 1) * stride + x0 : NULL;
+
+    u.skip(first);
+    for (c = first; c <= last; c++) {
+      b = u.next();
+      if (lo) { *lo = st7558_rop(*lo, b << s, loMask, rop); lo++; }
+      if (hi) { *hi = st7558_rop(*hi, b >> (8 - s), hiMask, rop); hi++; }
+    }
+    u.skip(w - 1 - last);
+  }
+}
@@ -0,0 +1,95 @@
+/***************************************************
+  Packed (run length coded) page-format bitmaps for the ST7558 library.
+
+  Layout, all bytes PROGMEM:
+
+    w, h                       size in pixels, w <= 255, h <= 255
+    runs ...                   the page-format bytes (ST7558_Blit.h),
+                               page by page, w bytes per page
+
+  Each run starts with a control byte c:
+
+    c < 0x80                   c + 1 literal bytes follow
+    c >= 0x80                  the next byte repeats (c & 0x7F) + 2 times
+
+  Runs may cross page boundaries. tools/packbitmap.py makes them from
+  PBM images. Blank and solid areas shrink to 2 bytes per 129, so a
+  typical 918 byte screen packs to a fraction of that.
+ ****************************************************/
+
+#ifndef _ST7558_PACK_H
+#define _ST7558_PACK_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+  #include "Arduino.h"
+#else
+  #include "WProgram.h"
+#endif
+
+#ifdef __AVR__
+ #include <avr/pgmspace.h>
+#elif defined(ESP8266)
+ #include <pgmspace.h>
+#endif
+
+#ifndef pgm_read_byte
+ #define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#endif
+
+#define ST7558_PACK_LITERAL 0x80   // control bytes below are literal runs
+#define ST7558_PACK_MIN_RUN 2      // shortest repeat run
+
+// Streams the bytes of a packed bitmap, no buffer
+class ST7558_Unpacker {
+
+ public:
+  // packed points at the w, h header
+  ST7558_Unpacker(const uint8_t *packed)
+    : p(packed + 2), left(0), repeat(false) { }
+
+  uint8_t next(void) {
+    uint8_t c;
+
+    if (!left) {
+      c = pgm_read_byte(p++);
+      repeat = c & ST7558_PACK_LITERAL;
+      left = repeat ? (c & 0x7F) + ST7558_PACK_MIN_RUN : c + 1;
+      if (repeat) value = pgm_read_byte(p++);
+    }
+    left--;
+    return repeat ? value : pgm_read_byte(p++);
+  }
+
+  // Drop n bytes, whole runs at a time
+  void skip(uint16_t n) {
+    uint8_t c;
+
+    while (n) {
+      if (!left) {
+        c = pgm_read_byte(p++);
+        repeat = c & ST7558_PACK_LITERAL;
+        left = repeat ? (c & 0x7F) + ST7558_PACK_MIN_RUN : c + 1;
+        if (repeat) value = pgm_read_byte(p++);
+      }
+      c = (n < left) ? n : left;
+      left -= c;
+      n -= c;
+      if (!repeat) p += c;
+    }
+  }
+
+ private:
+  const uint8_t *p;
+  uint8_t left, value;
+  boolean repeat;
+};
+
+// Unpack to (x, y) of a page-format destination 'stride' bytes per page,
+// clipped to the inclusive rectangle x0,y0 - x1,y1 and combined with a
+// raster op (ST7558_Blit.h). Any y works, each source byte is split over
+// the two destination pages it straddles.
+void st7558_unpack(uint8_t *dst, uint8_t stride, int16_t x, int16_t y,
+  const uint8_t *packed, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  uint8_t rop);
+
+#endif
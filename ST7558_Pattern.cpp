@@ -0,0 +1,42 @@
+/***************************************************
+  8x8 fill patterns for the ST7558 library.
+ ****************************************************/
+
+#include "ST7558_Pattern.h"
+
+const uint8_t st7558_patternLight[8] PROGMEM = {
+  0x88, 0x22, 0x88, 0x22, 0x88, 0x22, 0x88, 0x22
+};
+const uint8_t st7558_patternGrey[8] PROGMEM = {
+  0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55
+};
+const uint8_t st7558_patternDark[8] PROGMEM = {
+  0x77, 0xDD, 0x77, 0xDD, 0x77, 0xDD, 0x77, 0xDD
+};
+const uint8_t st7558_patternHatch[8] PROGMEM = {
+  0x11, 0x22, 0x44, 0x88, 0x11, 0x22, 0x44, 0x88
+};
+
+// Each of the 64 buffer pixels looks up the pattern pixel that lands on
+// it. Only the low 3 bits of any coordinate matter.
+void st7558_patternColumns(const uint8_t *pattern, uint8_t turns,
+  int16_t w, int16_t h, uint8_t *cols) {
+
+  uint8_t rows[8], x, y, px, py;
+
+  for (y = 0; y < 8; y++)
+    rows[y] = pgm_read_byte(pattern + y);
+  for (x = 0; x < 8; x++) {
+    cols[x] = 0;
+    for (y = 0; y < 8; y++) {
+      switch (turns & 3) {
+        case 1:  px = h - 1 - y; py = x;         break;
+        case 2:  px = w - 1 - x; py = h - 1 - y; break;
+        case 3:  px = y;         py = w - 1 - x; break;
+        default: px = x;         py = y;         break;
+      }
+      if (rows[py & 7] & (0x80 >> (px & 7)))
+        cols[x] |= 1 << y;
+    }
+  }
+}
@@ -0,0 +1,32 @@
+/***************************************************
+  8x8 fill patterns for the ST7558 library.
+
+  A pattern is 8 bytes in PROGMEM, one per row, MSB on the left, like a
+  row of drawBitmap(). It tiles from the screen's top left corner in
+  any rotation, so neighbouring fills line up.
+
+  Page bytes hold 8 rows of one column, and pages are 8 rows high, so a
+  pattern column is also a whole page byte on every page. The fills
+  turn the pattern into those 8 column bytes once per call, for the
+  display's rotation, and then store them the way a solid fill stores
+  0x00 or 0xFF.
+ ****************************************************/
+
+#ifndef _ST7558_PATTERN_H
+#define _ST7558_PATTERN_H
+
+#include "ST7558_Pack.h"
+
+// Stock patterns: share of the pattern's pixels drawn in color
+extern const uint8_t st7558_patternLight[8] PROGMEM;   // 25%, dots
+extern const uint8_t st7558_patternGrey[8] PROGMEM;    // 50%, checkerboard
+extern const uint8_t st7558_patternDark[8] PROGMEM;    // 75%
+extern const uint8_t st7558_patternHatch[8] PROGMEM;   // diagonal lines
+
+// Column bytes of pattern for columns x & 7 == 0 .. 7 of a w x h
+// page-format buffer shown in rotation 'turns', as the display maps it.
+// Bit r of a column byte is row r of every page.
+void st7558_patternColumns(const uint8_t *pattern, uint8_t turns,
+  int16_t w, int16_t h, uint8_t *cols);
+
+#endif
@@ -0,0 +1,120 @@
+/***************************************************
+  Delta coded animations for the ST7558 library.
+ ****************************************************/
+
+#include "ST7558_Player.h"
+
+ST7558_Player::ST7558_Player(ST7558 &lcd, const uint8_t *anim)
+  : lcd(lcd), anim(anim), pos(anim), loopPos(NULL), in(NULL),
+    count(0), frame(0), period(0), due(0)
+{
+}
+
+ST7558_Player::ST7558_Player(ST7558 &lcd, Stream &in)
+  : lcd(lcd), anim(NULL), pos(NULL), loopPos(NULL), in(&in),
+    count(0), frame(0), period(0), due(0)
+{
+}
+
+boolean ST7558_Player::begin(uint8_t x, uint8_t page) {
+  int16_t header[6];
+  uint8_t i;
+
+  x0 = x;
+  page0 = page;
+  pos = anim;
+  loopPos = NULL;
+  for (i = 0; i < sizeof(header) / sizeof(header[0]); i++)
+    if ((header[i] = read()) < 0) return false;   // stream timed out
+  w = header[0];
+  pages = header[1];
+  setFrameRate(header[2]);
+  flags = header[3];
+  count = header[4] | (header[5] << 8);
+  frame = 0;
+  due = millis();
+  return true;
+}
+
+void ST7558_Player::setFrameRate(uint8_t fps) {
+  period = fps ? 1000 / fps : 0;
+}
+
+// Frames keep to a fixed schedule. One that comes too late is shown right
+// away and the schedule starts over from it, rather than rushing the
+// following frames to catch up.
+boolean ST7558_Player::update(void) {
+  unsigned long now = millis();
+
+  if ((long)(now - due) < 0) return true;
+  due += period;
+  if ((long)(now - due) >= 0) due = now + period;
+  return nextFrame();
+}
+
+// A stream that times out anywhere in a frame ends playback
+boolean ST7558_Player::nextFrame(void) {
+  int16_t page, x, n, keep;
+  boolean complete;
+
+  // count 0: a stream that plays for as long as frames arrive
+  if (count && (frame >= count)) {
+    if (!anim || !(flags & ST7558_ANIM_LOOP)) return false;
+    frame = 0;                        // the loop frame shows frame 0
+  }
+
+  for (;;) {
+    if ((page = read()) < 0) return false;
+    if (page == ST7558_ANIM_END) break;
+    if (((x = read()) < 0) || ((n = read()) < 0)) return false;
+
+    // The part of the span inside the window and on the display
+    keep = 0;
+    if ((page < pages) && (page0 + page < ST7558_PAGES))
+      keep = min(n, min(w, ST7558_RAM_WIDTH - x0) - x);
+    if (keep > 0) {
+      complete = copy(&st7558_buffer[page0 + page][x0 + x], keep);
+      lcd.displaySpan(page0 + page, x0 + x, keep);
+      if (!complete) return false;
+    } else {
+      keep = 0;
+    }
+    if (!skip(n - keep)) return false;
+  }
+
+  if (anim && !frame) {
+    if (loopPos)
+      pos = loopPos;                  // back from the loop frame
+    else
+      loopPos = pos;                  // frame 1 starts here
+  }
+  frame++;
+  return true;
+}
+
+// Next byte, -1 if the stream timed out
+int16_t ST7558_Player::read(void) {
+  uint8_t b;
+
+  if (anim) return pgm_read_byte(pos++);
+  return in->readBytes((char *)&b, 1) ? b : -1;
+}
+
+// False if the stream timed out first; the bytes it did not send are 0
+boolean ST7558_Player::copy(uint8_t *to, uint8_t n) {
+  uint8_t got;
+
+  if (anim) {
+    while (n--) *to++ = pgm_read_byte(pos++);
+    return true;
+  }
+  got = in->readBytes((char *)to, n);
+  if (got < n) memset(to + got, 0, n - got);
+  return got == n;
+}
+
+boolean ST7558_Player::skip(uint16_t n) {
+  while (n--)
+    if (read() < 0) return false;
+  return true;
+}
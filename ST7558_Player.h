@@ -0,0 +1,64 @@
+/***************************************************
+  Delta coded animations for the ST7558 library.
+
+  An animation is a header and a run of frames. Each frame lists only the
+  page spans that differ from the frame before it; the first frame is
+  coded against a blank area.
+
+    w, pages, fps, flags, count (2 bytes, LSB first)
+    frame:  { page, x, n, n bytes } ... ST7558_ANIM_END
+
+  Pages and columns are relative to where the animation plays and in the
+  controller's own orientation. With ST7558_ANIM_LOOP in flags one more
+  frame follows the last one, taking it back to the first frame, and
+  playback carries on from the second.
+
+  ST7558_Player copies each span into the framebuffer and sends just
+  that span to the display, so a frame costs bus time in proportion to
+  what changed. Frames come from PROGMEM or from a Stream, such as Serial
+  fed by a host or a file on an SD card. A stream that times out stops
+  playback: nextFrame() returns false, as what follows could not be told
+  apart from span headers. Spans are clipped to the w x pages window the
+  header declares. tools/animpack.py makes both from PBM frames.
+ ****************************************************/
+
+#ifndef _ST7558_PLAYER_H
+#define _ST7558_PLAYER_H
+
+#include "ST7558.h"
+
+#define ST7558_ANIM_END    0xFF   // page byte that ends a frame
+#define ST7558_ANIM_LOOP   0x01   // flags: a loop frame follows the last
+
+class ST7558_Player {
+
+ public:
+  ST7558_Player(ST7558 &lcd, const uint8_t *anim);   // PROGMEM
+  ST7558_Player(ST7558 &lcd, Stream &in);
+
+  // Read the header and play at column x, page 'page' of the display
+  boolean begin(uint8_t x = 0, uint8_t page = 0);
+
+  void setFrameRate(uint8_t fps);
+
+  boolean
+    update(void),      // Show the next frame once it is due, false when done
+    nextFrame(void);   // Show the next frame now, false when done
+
+  // Frame on the display, from 0
+  uint16_t getFrame(void) const { return frame ? frame - 1 : 0; }
+
+ private:
+  int16_t read(void);
+  boolean copy(uint8_t *to, uint8_t n),
+    skip(uint16_t n);
+
+  ST7558 &lcd;
+  const uint8_t *anim, *pos, *loopPos;
+  Stream *in;
+  uint8_t x0, page0, w, pages, flags;
+  uint16_t count, frame;
+  unsigned long period, due;
+};
+
+#endif
@@ -0,0 +1,81 @@
+/***************************************************
+  Fixed block memory pool for the ST7558 library.
+ ****************************************************/
+
+#include "ST7558_Pool.h"
+
+#define NONE 0xFF
+
+#define BYTES0 ((uint16_t)ST7558_POOL_BLOCKS0 << ST7558_POOL_SHIFT0)
+#define BYTES1 ((uint16_t)ST7558_POOL_BLOCKS1 << ST7558_POOL_SHIFT1)
+#define BYTES2 ((uint16_t)ST7558_POOL_BLOCKS2 << ST7558_POOL_SHIFT2)
+
+// Word aligned, the classes back to back
+static uint32_t arena[(BYTES0 + BYTES1 + BYTES2) / 4];
+
+static const uint8_t shift[ST7558_POOL_CLASSES] = {
+  ST7558_POOL_SHIFT0, ST7558_POOL_SHIFT1, ST7558_POOL_SHIFT2
+};
+static const uint8_t blocks[ST7558_POOL_CLASSES] = {
+  ST7558_POOL_BLOCKS0, ST7558_POOL_BLOCKS1, ST7558_POOL_BLOCKS2
+};
+static const uint16_t start[ST7558_POOL_CLASSES + 1] = {
+  0, BYTES0, BYTES0 + BYTES1, BYTES0 + BYTES1 + BYTES2
+};
+
+// Released blocks form a list through their first byte. Blocks never
+// handed out are taken in order, so nothing needs setting up.
+static uint8_t freeList[ST7558_POOL_CLASSES] = { NONE, NONE, NONE },
+  fresh[ST7558_POOL_CLASSES],
+  used[ST7558_POOL_CLASSES],
+  highWater[ST7558_POOL_CLASSES];
+static uint16_t failed[ST7558_POOL_CLASSES];
+
+static uint8_t *block(uint8_t cls, uint8_t i) {
+  return (uint8_t *)arena + start[cls] + ((uint16_t)i << shift[cls]);
+}
+
+void *st7558_alloc(uint16_t size) {
+  uint8_t cls, first = NONE, i;
+
+  for (cls = 0; cls < ST7558_POOL_CLASSES; cls++) {
+    if (size > (1U << shift[cls])) continue;
+    if (first == NONE) first = cls;
+    if (freeList[cls] != NONE) {
+      i = freeList[cls];
+      freeList[cls] = *block(cls, i);
+    } else if (fresh[cls] < blocks[cls]) {
+      i = fresh[cls]++;
+    } else {
+      continue;               // full, try a bigger class
+    }
+    if (++used[cls] > highWater[cls]) highWater[cls] = used[cls];
+    return block(cls, i);
+  }
+  failed[(first != NONE) ? first : ST7558_POOL_CLASSES - 1]++;
+  return NULL;
+}
+
+void st7558_free(void *p) {
+  uint16_t offset;
+  uint8_t cls, i;
+
+  if (!p) return;
+  offset = (uint8_t *)p - (uint8_t *)arena;
+  for (cls = 0; offset >= start[cls + 1]; cls++)
+    ;
+  i = (offset - start[cls]) >> shift[cls];
+  *block(cls, i) = freeList[cls];
+  freeList[cls] = i;
+  used[cls]--;
+}
+
+boolean st7558_poolStats(uint8_t cls, ST7558_PoolStats *stats) {
+  if (cls >= ST7558_POOL_CLASSES) return false;
+  stats->blockSize = 1U << shift[cls];
+  stats->blocks = blocks[cls];
+  stats->used = used[cls];
+  stats->highWater = highWater[cls];
+  stats->failed = failed[cls];
+  return true;
+}
@@ -0,0 +1,47 @@
+/***************************************************
+  Fixed block memory pool for the ST7558 library.
+
+  Canvases and sprite save-under buffers the library allocates itself
+  come from here instead of the heap. The pool is one static arena cut
+  into three size classes of fixed blocks, each class a free list, so
+  allocation and release take constant time, memory never fragments, and
+  the RAM the graphics use is known when the sketch is linked.
+
+  A request gets a block of the smallest class it fits in, or NULL when
+  that class and the larger ones are used up. Class block sizes are
+  powers of two; change the counts and sizes below to suit the sketch.
+  st7558_poolStats() reports how full each class is and has ever been.
+ ****************************************************/
+
+#ifndef _ST7558_POOL_H
+#define _ST7558_POOL_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+  #include "Arduino.h"
+#else
+  #include "WProgram.h"
+#endif
+
+// Block size (1 << shift bytes, 4 and up) and number of blocks per class
+#define ST7558_POOL_SHIFT0  4     // 16 bytes: small sprites
+#define ST7558_POOL_BLOCKS0 8
+#define ST7558_POOL_SHIFT1  6     // 64 bytes: sprites, text lines
+#define ST7558_POOL_BLOCKS1 4
+#define ST7558_POOL_SHIFT2  8     // 256 bytes: canvases
+#define ST7558_POOL_BLOCKS2 1
+
+#define ST7558_POOL_CLASSES 3
+
+typedef struct {
+  uint16_t blockSize;
+  uint8_t blocks,
+    used,             // blocks out now
+    highWater;        // most blocks ever out at once
+  uint16_t failed;    // requests that got nothing
+} ST7558_PoolStats;
+
+void *st7558_alloc(uint16_t size);
+void st7558_free(void *p);                  // NULL is fine
+boolean st7558_poolStats(uint8_t cls, ST7558_PoolStats *stats);
+
+#endif
@@ -0,0 +1,355 @@
+/***************************************************
+  Region operations on page-format buffers for the ST7558 library.
+ ****************************************************/
+
+#ifdef __AVR__
+ #include <avr/pgmspace.h>
+#elif defined(ESP8266)
+ #include <pgmspace.h>
+#endif
+
+#ifndef pgm_read_byte
+ #define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#endif
+
+#include <string.h>
+#include "ST7558_Region.h"
+
+// A machine word of page row bytes, one column per lane
+#ifdef __AVR__
+typedef uint8_t lane_t;
+#else
+typedef uint32_t lane_t;
+#endif
+#define WORD ((uint8_t)sizeof(lane_t))
+
+// b in every lane
+template <class T> static inline T lanes(uint8_t b) {
+  return (T)((T)~(T)0 / 0xFF * b);
+}
+
+// st7558_rop() for every lane
+template <class T> static inline T ropLanes(T d, T s, T m, uint8_t rop) {
+  s &= m;
+  switch (rop) {
+    case ST7558_ROP_OR:     return d | s;
+    case ST7558_ROP_AND:    return d & (s | ~m);
+    case ST7558_ROP_XOR:    return d ^ s;
+    case ST7558_ROP_ANDNOT: return d & ~s;
+    default:                return (d & ~m) | s;
+  }
+}
+
+// Rows s.. of page lo with the top rows of page hi filled in below them,
+// for every lane
+template <class T> static inline T shiftLanes(T lo, T hi, uint8_t s) {
+  if (!s) return lo;
+  return ((lo >> s) & lanes<T>(0xFF >> s)) |
+         ((hi << (8 - s)) & lanes<T>(0xFF << (8 - s)));
+}
+
+// Dark pixels in x, summed over the lanes
+template <class T> static inline uint8_t countLanes(T x) {
+  x = x - ((x >> 1) & lanes<T>(0x55));
+  x = (x & lanes<T>(0x33)) + ((x >> 2) & lanes<T>(0x33));
+  x = (x + (x >> 4)) & lanes<T>(0x0F);
+  return (T)(x * lanes<T>(1)) >> (8 * (sizeof(T) - 1));
+}
+
+// Word loads and stores. Destination words are aligned; source rows sit
+// at any offset from them, and memcpy() reads those safely on targets
+// that fault on unaligned loads.
+static inline lane_t load(const uint8_t *p) {
+  lane_t w;
+
+  memcpy(&w, p, sizeof(w));
+  return w;
+}
+
+static inline lane_t loadAligned(const uint8_t *p) {
+  lane_t w;
+
+  memcpy(&w, __builtin_assume_aligned(p, sizeof(lane_t)), sizeof(w));
+  return w;
+}
+
+static inline void storeAligned(uint8_t *p, lane_t w) {
+  memcpy(__builtin_assume_aligned(p, sizeof(lane_t)), &w, sizeof(w));
+}
+
+static inline boolean aligned(const uint8_t *p) {
+  return !((uintptr_t)p & (WORD - 1));
+}
+
+// One page row of n columns: source rows from lo shifted up by s, the
+// next page hi below them (either may be NULL, reading as blank),
+// combined into d under mask. Backward runs from the right, for copies
+// to the right within one row.
+static void copyRow(uint8_t *d, const uint8_t *lo, const uint8_t *hi,
+  uint8_t n, uint8_t s, uint8_t mask, uint8_t rop, boolean backward) {
+
+  lane_t m = lanes<lane_t>(mask), l, h;
+  uint8_t i, b;
+
+#define COPY_BYTE(i) \
+  b = shiftLanes<uint8_t>(lo ? lo[i] : 0, hi ? hi[i] : 0, s); \
+  d[i] = st7558_rop(d[i], b, mask, rop);
+#define COPY_WORD(i) \
+  l = lo ? load(lo + (i)) : 0; \
+  h = hi ? load(hi + (i)) : 0; \
+  storeAligned(d + (i), \
+    ropLanes<lane_t>(loadAligned(d + (i)), shiftLanes<lane_t>(l, h, s), m, rop));
+
+  if (!backward) {
+    for (i = 0; (i < n) && !aligned(d + i); i++) {
+      COPY_BYTE(i)
+    }
+    for (; n - i >= WORD; i += WORD) {
+      COPY_WORD(i)
+    }
+    for (; i < n; i++) {
+      COPY_BYTE(i)
+    }
+  } else {
+    for (i = n; i && !aligned(d + i); ) {
+      i--;
+      COPY_BYTE(i)
+    }
+    for (; i >= WORD; ) {
+      i -= WORD;
+      COPY_WORD(i)
+    }
+    while (i) {
+      i--;
+      COPY_BYTE(i)
+    }
+  }
+#undef COPY_BYTE
+#undef COPY_WORD
+}
+
+void st7558_regionFill(uint8_t *buf, uint8_t stride,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t rop) {
+
+  uint8_t page, lastPage, mask, n, i, *p;
+  lane_t m;
+
+  if ((x0 > x1) || (y0 > y1)) return;
+  n = x1 - x0 + 1;
+  lastPage = y1 >> 3;
+  for (page = y0 >> 3; page <= lastPage; page++) {
+    mask = 0xFF;
+    if (page == (y0 >> 3)) mask &= 0xFF << (y0 & 7);
+    if (page == lastPage)  mask &= 0xFF >> (7 - (y1 & 7));
+    m = lanes<lane_t>(mask);
+    p = buf + page * stride + x0;
+    for (i = 0; (i < n) && !aligned(p + i); i++)
+      p[i] = st7558_rop(p[i], 0xFF, mask, rop);
+    for (; n - i >= WORD; i += WORD)
+      storeAligned(p + i, ropLanes<lane_t>(loadAligned(p + i), ~(lane_t)0, m, rop));
+    for (; i < n; i++)
+      p[i] = st7558_rop(p[i], 0xFF, mask, rop);
+  }
+}
+
+// Destination pages run away from the source when both share a buffer,
+// and columns likewise, so nothing is read after it was overwritten.
+void st7558_regionCopy(uint8_t *dst, uint8_t dstStride, int16_t dx, int16_t dy,
+  const uint8_t *src, uint8_t srcStride,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t rop) {
+
+  int16_t first, last, page, off, q, firstQ = y0 >> 3, lastQ = y1 >> 3;
+  const uint8_t *lo, *hi;
+  uint8_t mask, s;
+  boolean same = (dst == src), up;
+
+  if ((x0 > x1) || (y0 > y1)) return;
+  first = dy >> 3;
+  last = (dy + y1 - y0) >> 3;
+  up = !same || (dy <= y0);
+  for (page = up ? first : last; up ? (page <= last) : (page >= first);
+       page += up ? 1 : -1) {
+    mask = 0xFF;
+    if (page == first) mask &= 0xFF << (dy & 7);
+    if (page == last)  mask &= 0xFF >> (7 - ((dy + y1 - y0) & 7));
+
+    // Source row landing on bit 0 of this page, as in st7558_blit()
+    off = page * 8 - dy + y0;
+    q = (off + 8) / 8 - 1;
+    s = off - q * 8;
+    lo = ((q >= firstQ) && (q <= lastQ)) ? src + q * srcStride + x0 : NULL;
+    hi = (s && (q + 1 >= firstQ) && (q + 1 <= lastQ)) ?
+      src + (q + 1) * srcStride + x0 : NULL;
+    copyRow(dst + page * dstStride + dx, lo, hi, x1 - x0 + 1, s, mask, rop,
+      same && (dx > x0));
+  }
+}
+
+// Each block is 8 column bytes of the area shifted up to the block's top
+// row, as the turned blits take them from an image
+void st7558_regionRotate(uint8_t *dst, uint8_t dstStride, int16_t dx,
+  int16_t dy, const uint8_t *src, uint8_t srcStride,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  int16_t cx0, int16_t cy0, int16_t cx1, int16_t cy1,
+  uint8_t rop, uint8_t turns) {
+
+  int16_t w = x1 - x0 + 1, h = y1 - y0 + 1, bc, br, y, t;
+  const uint8_t *p;
+  uint8_t block[8], cw, i, s;
+  boolean two;
+
+  if ((x0 > x1) || (y0 > y1)) return;
+  turns &= 3;
+  if (!turns) {
+    if ((t = cx0 - dx) > 0) { x0 += t; dx += t; }
+    if ((t = cy0 - dy) > 0) { y0 += t; dy += t; }
+    if ((t = dx + x1 - x0 - cx1) > 0) x1 -= t;
+    if ((t = dy + y1 - y0 - cy1) > 0) y1 -= t;
+    st7558_regionCopy(dst, dstStride, dx, dy, src, srcStride,
+      x0, y0, x1, y1, rop);
+    return;
+  }
+
+  for (br = 0; br < h; br += 8) {
+    y = y0 + br;
+    s = y & 7;
+    p = src + (y >> 3) * srcStride + x0;
+    two = s && ((min(y + 7, y1) >> 3) > (y >> 3));
+    for (bc = 0; bc < w; bc += 8) {
+      cw = (w - bc < 8) ? w - bc : 8;
+      for (i = 0; i < cw; i++) {
+        block[i] = p[bc + i] >> s;
+        if (two) block[i] |= p[srcStride + bc + i] << (8 - s);
+      }
+      st7558_blitTurnedBlock(dst, dstStride, dx, dy, w, h, bc, br, block, cw,
+        cx0, cy0, cx1, cy1, rop, turns);
+    }
+  }
+}
+
+void st7558_regionShift(uint8_t *buf, uint8_t stride,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t dx, int16_t dy) {
+
+  if ((x0 > x1) || (y0 > y1)) return;
+  if ((abs(dx) > x1 - x0) || (abs(dy) > y1 - y0)) {
+    st7558_regionFill(buf, stride, x0, y0, x1, y1, ST7558_ROP_ANDNOT);
+    return;
+  }
+  st7558_regionCopy(buf, stride, x0 + max(dx, 0), y0 + max(dy, 0), buf, stride,
+    x0 - min(dx, 0), y0 - min(dy, 0), x1 - max(dx, 0), y1 - max(dy, 0),
+    ST7558_ROP_COPY);
+
+  // What the move uncovered
+  if (dx > 0) st7558_regionFill(buf, stride, x0, y0, x0 + dx - 1, y1, ST7558_ROP_ANDNOT);
+  if (dx < 0) st7558_regionFill(buf, stride, x1 + dx + 1, y0, x1, y1, ST7558_ROP_ANDNOT);
+  if (dy > 0) st7558_regionFill(buf, stride, x0, y0, x1, y0 + dy - 1, ST7558_ROP_ANDNOT);
+  if (dy < 0) st7558_regionFill(buf, stride, x0, y1 + dy + 1, x1, y1, ST7558_ROP_ANDNOT);
+}
+
+uint16_t st7558_regionCount(const uint8_t *buf, uint8_t stride,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+
+  uint8_t page, lastPage, mask, n, i;
+  const uint8_t *p;
+  uint16_t count = 0;
+  lane_t m;
+
+  if ((x0 > x1) || (y0 > y1)) return 0;
+  n = x1 - x0 + 1;
+  lastPage = y1 >> 3;
+  for (page = y0 >> 3; page <= lastPage; page++) {
+    mask = 0xFF;
+    if (page == (y0 >> 3)) mask &= 0xFF << (y0 & 7);
+    if (page == lastPage)  mask &= 0xFF >> (7 - (y1 & 7));
+    m = lanes<lane_t>(mask);
+    p = buf + page * stride + x0;
+    for (i = 0; (i < n) && !aligned(p + i); i++)
+      count += countLanes<uint8_t>(p[i] & mask);
+    for (; n - i >= WORD; i += WORD)
+      count += countLanes<lane_t>(loadAligned(p + i) & m);
+    for (; i < n; i++)
+      count += countLanes<uint8_t>(p[i] & mask);
+  }
+  return count;
+}
+
+boolean st7558_regionAny(const uint8_t *buf, uint8_t stride,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+
+  uint8_t page, lastPage, mask, n, i;
+  const uint8_t *p;
+  lane_t m;
+
+  if ((x0 > x1) || (y0 > y1)) return false;
+  n = x1 - x0 + 1;
+  lastPage = y1 >> 3;
+  for (page = y0 >> 3; page <= lastPage; page++) {
+    mask = 0xFF;
+    if (page == (y0 >> 3)) mask &= 0xFF << (y0 & 7);
+    if (page == lastPage)  mask &= 0xFF >> (7 - (y1 & 7));
+    m = lanes<lane_t>(mask);
+    p = buf + page * stride + x0;
+    for (i = 0; (i < n) && !aligned(p + i); i++)
+      if (p[i] & mask) return true;
+    for (; n - i >= WORD; i += WORD)
+      if (loadAligned(p + i) & m) return true;
+    for (; i < n; i++)
+      if (p[i] & mask) return true;
+  }
+  return false;
+}
+
+static inline uint8_t read(const uint8_t *p, boolean progmem) {
+  return progmem ? pgm_read_byte(p) : *p;
+}
+
+// Pages of a in turn, b's rows shifted onto each as st7558_blit() does.
+// Words of columns at a time when both are in RAM.
+boolean st7558_regionOverlap(const uint8_t *a, uint8_t stride,
+  boolean aProgmem, int16_t x, int16_t y, const uint8_t *b, int16_t w,
+  int16_t h, boolean bProgmem,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+
+  int16_t page, lastPage, r, q, srcPages, n, i;
+  const uint8_t *pa, *lo, *hi;
+  uint8_t mask, s, bits;
+  lane_t m;
+
+  if ((w <= 0) || (h <= 0)) return false;
+  if (x0 < x) x0 = x;
+  if (y0 < y) y0 = y;
+  if (x1 > x + w - 1) x1 = x + w - 1;
+  if (y1 > y + h - 1) y1 = y + h - 1;
+  if ((x0 > x1) || (y0 > y1)) return false;
+
+  n = x1 - x0 + 1;
+  srcPages = (h + 7) >> 3;
+  lastPage = y1 >> 3;
+  for (page = y0 >> 3; page <= lastPage; page++) {
+    mask = 0xFF;
+    if (page == (y0 >> 3)) mask &= 0xFF << (y0 & 7);
+    if (page == lastPage)  mask &= 0xFF >> (7 - (y1 & 7));
+    m = lanes<lane_t>(mask);
+
+    r = page * 8 - y;
+    q = (r + 8) / 8 - 1;
+    s = r - q * 8;
+    lo = (b && (q >= 0)) ? b + q * w + x0 - x : NULL;
+    hi = (b && s && (q + 1 < srcPages)) ? b + (q + 1) * w + x0 - x : NULL;
+    pa = a ? a + page * stride + x0 : NULL;
+
+    i = 0;
+    if (a && b && !aProgmem && !bProgmem) {
+      for (; n - i >= WORD; i += WORD)
+        if (load(pa + i) & m & shiftLanes<lane_t>(lo ? load(lo + i) : 0,
+            hi ? load(hi + i) : 0, s)) return true;
+    }
+    for (; i < n; i++) {
+      bits = b ? shiftLanes<uint8_t>(lo ? read(lo + i, bProgmem) : 0,
+        hi ? read(hi + i, bProgmem) : 0, s) : 0xFF;
+      if (a) bits &= read(pa + i, aProgmem);
+      if (bits & mask) return true;
+    }
+  }
+  return false;
+}
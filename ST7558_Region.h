@@ -0,0 +1,70 @@
+/***************************************************
+  Region operations on page-format buffers for the ST7558 library.
+
+  Bulk operations over a rectangle of a page-format buffer (see
+  ST7558_Blit.h), 'stride' bytes per page, corners inclusive and already
+  inside the buffer. They go a machine word of columns at a time: the
+  bytes of one page row are lanes, so a vertical bit shift, a raster op
+  or a pixel count is done for 4 columns at once on 32 bit targets and
+  1 on AVR, which has no wider registers worth the trouble.
+
+  st7558_regionCopy() may copy within one buffer, overlapping areas
+  included, like memmove(). st7558_regionRotate() turns an area a
+  quarter turn at a time, 8x8 pixels per bit matrix transpose.
+  ST7558_Surface wraps them in logical coordinates (invertRect(),
+  copyRect(), turnRect(), scrollRect(), countPixels(), anyPixel(),
+  hitBitmap()) for the display and canvases alike.
+
+  The hit tests, st7558_regionAny() and st7558_regionOverlap(), return
+  at the first dark pixel they find, so a miss costs a scan of the area
+  and a hit usually much less.
+ ****************************************************/
+
+#ifndef _ST7558_REGION_H
+#define _ST7558_REGION_H
+
+#include "ST7558_Blit.h"
+
+// Combine every pixel of the area with a dark pixel: ST7558_ROP_COPY and
+// ST7558_ROP_OR darken, ST7558_ROP_ANDNOT clears, ST7558_ROP_XOR inverts
+void st7558_regionFill(uint8_t *buf, uint8_t stride,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t rop);
+
+// Combine the area x0,y0 - x1,y1 of src into dst at (dx, dy)
+void st7558_regionCopy(uint8_t *dst, uint8_t dstStride, int16_t dx, int16_t dy,
+  const uint8_t *src, uint8_t srcStride,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t rop);
+
+// Combine the area x0,y0 - x1,y1 of src into dst turned as
+// st7558_blitTurned() turns an image, the turned area's top left corner
+// at (dx, dy), within the destination clip cx0,cy0 - cx1,cy1. The areas
+// must not overlap. 8x8 blocks go through st7558_transpose8().
+void st7558_regionRotate(uint8_t *dst, uint8_t dstStride, int16_t dx,
+  int16_t dy, const uint8_t *src, uint8_t srcStride,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  int16_t cx0, int16_t cy0, int16_t cx1, int16_t cy1,
+  uint8_t rop, uint8_t turns);
+
+// Move the contents of the area by (dx, dy) pixels within it, clearing
+// what is left behind
+void st7558_regionShift(uint8_t *buf, uint8_t stride,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t dx, int16_t dy);
+
+// Dark pixels in the area
+uint16_t st7558_regionCount(const uint8_t *buf, uint8_t stride,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+// Whether the area has any dark pixel
+boolean st7558_regionAny(const uint8_t *buf, uint8_t stride,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+// Whether a dark pixel of the w x h page-format image b, its top left
+// corner at (x, y) of the page-format buffer a, lies on a dark pixel of
+// a within x0,y0 - x1,y1. Either may be in PROGMEM, or NULL for an all
+// dark one.
+boolean st7558_regionOverlap(const uint8_t *a, uint8_t stride,
+  boolean aProgmem, int16_t x, int16_t y, const uint8_t *b, int16_t w,
+  int16_t h, boolean bProgmem,
+  int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+#endif
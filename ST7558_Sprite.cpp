@@ -0,0 +1,222 @@
+/***************************************************
+  Sprites for the ST7558 library.
+ ****************************************************/
+
+#include "ST7558_Sprite.h"
+
+ST7558_Sprite::ST7558_Sprite(const uint8_t *bitmap, const uint8_t *mask,
+  int16_t w, int16_t h, uint8_t *save)
+  : bitmap(bitmap), mask(mask), save(save), x(0), y(0), w(w), h(h),
+    mode(ST7558_SPRITE_MASKED), visible(true), pooled(!save), drawn(false)
+{
+  if (pooled)
+    this->save = (uint8_t *)st7558_alloc(ST7558_SPRITE_SAVE(w, h));
+}
+
+ST7558_Sprite::ST7558_Sprite(const uint8_t *bitmap, int16_t w, int16_t h)
+  : bitmap(bitmap), mask(NULL), save(NULL), x(0), y(0), w(w), h(h),
+    mode(ST7558_SPRITE_XOR), visible(true), pooled(false), drawn(false)
+{
+}
+
+ST7558_Sprite::~ST7558_Sprite() {
+  if (pooled)
+    st7558_free(save);
+}
+
+void ST7558_Sprite::moveTo(int16_t nx, int16_t ny) {
+  x = nx;
+  y = ny;
+}
+
+// Next animation frame, same size
+void ST7558_Sprite::setBitmap(const uint8_t *b, const uint8_t *m) {
+  bitmap = b;
+  mask = m;
+}
+
+void ST7558_Sprite::show(void) {
+  visible = true;
+}
+
+void ST7558_Sprite::hide(void) {
+  visible = false;
+}
+
+boolean ST7558_Sprite::changed(void) const {
+  if (visible != drawn) return true;
+  return drawn && ((x != drawnX) || (y != drawnY) ||
+    (bitmap != drawnBitmap) || (mask != drawnMask));
+}
+
+const uint8_t *ST7558_Sprite::shape(void) const {
+  return (mode == ST7558_SPRITE_XOR) ? bitmap : mask;
+}
+
+boolean ST7558_Sprite::collides(const ST7558_Sprite &other) const {
+  if (!visible || !other.visible) return false;
+  return st7558_regionOverlap(shape(), w, true, other.x - x, other.y - y,
+    other.shape(), other.w, other.h, true, 0, 0, w - 1, h - 1);
+}
+
+boolean ST7558_Sprite::collides(ST7558 &lcd) const {
+  return visible && lcd.hitBitmap_P(x, y, shape(), w, h);
+}
+
+/***************************************************************************/
+
+ST7558_Sprites::ST7558_Sprites(ST7558 &lcd)
+  : lcd(lcd), count(0)
+{
+}
+
+boolean ST7558_Sprites::add(ST7558_Sprite &s) {
+  if (count >= ST7558_SPRITES_MAX) return false;
+  if ((s.mode == ST7558_SPRITE_MASKED) && !s.save) return false;
+  sprite[count++] = &s;
+  return true;
+}
+
+// Stacking order: masked sprites as added, XOR ones over all of them
+uint8_t ST7558_Sprites::depth(uint8_t i) const {
+  return (sprite[i]->mode == ST7558_SPRITE_XOR) ? ST7558_SPRITES_MAX + i : i;
+}
+
+static boolean intersects(int16_t ax, int16_t ay, int16_t bx, int16_t by,
+  int16_t w0, int16_t h0, int16_t w1, int16_t h1) {
+  return (ax < bx + w1) && (bx < ax + w0) && (ay < by + h1) && (by < ay + h0);
+}
+
+// Whether a's old or new place touches b's
+boolean ST7558_Sprites::overlaps(const ST7558_Sprite *a,
+  const ST7558_Sprite *b) const {
+
+  if (a->drawn && b->drawn && intersects(a->drawnX, a->drawnY,
+      b->drawnX, b->drawnY, a->w, a->h, b->w, b->h)) return true;
+  if (a->drawn && b->visible && intersects(a->drawnX, a->drawnY,
+      b->x, b->y, a->w, a->h, b->w, b->h)) return true;
+  if (a->visible && b->drawn && intersects(a->x, a->y,
+      b->drawnX, b->drawnY, a->w, a->h, b->w, b->h)) return true;
+  return a->visible && b->visible &&
+    intersects(a->x, a->y, b->x, b->y, a->w, a->h, b->w, b->h);
+}
+
+// Changed sprites come off and go back on. So does every sprite stacked
+// over one of them where they overlap: its save buffer holds the pixels
+// being changed. Everything comes off top down and goes on bottom up.
+void ST7558_Sprites::update(void) {
+  boolean redo[ST7558_SPRITES_MAX], more;
+  uint8_t i, j;
+
+  for (i = 0; i < count; i++)
+    redo[i] = sprite[i]->changed();
+  do {
+    more = false;
+    for (i = 0; i < count; i++) {
+      if (!redo[i]) continue;
+      for (j = 0; j < count; j++) {
+        if (!redo[j] && (depth(j) > depth(i)) &&
+            overlaps(sprite[i], sprite[j])) {
+          redo[j] = more = true;
+        }
+      }
+    }
+  } while (more);
+
+  for (i = count; i--; )
+    if (redo[i] && (sprite[i]->mode == ST7558_SPRITE_XOR)) takeOff(sprite[i]);
+  for (i = count; i--; )
+    if (redo[i] && (sprite[i]->mode != ST7558_SPRITE_XOR)) takeOff(sprite[i]);
+  for (i = 0; i < count; i++)
+    if (redo[i] && (sprite[i]->mode != ST7558_SPRITE_XOR)) putOn(sprite[i]);
+  for (i = 0; i < count; i++)
+    if (redo[i] && (sprite[i]->mode == ST7558_SPRITE_XOR)) putOn(sprite[i]);
+}
+
+void ST7558_Sprites::erase(void) {
+  uint8_t i;
+
+  for (i = count; i--; )
+    if (sprite[i]->mode == ST7558_SPRITE_XOR) takeOff(sprite[i]);
+  for (i = count; i--; )
+    if (sprite[i]->mode != ST7558_SPRITE_XOR) takeOff(sprite[i]);
+}
+
+// Bring back what was under the sprite. The buffer holds whole pages but
+// only the sprite's own rows go back: the rest of a page may have changed
+// under other sprites since.
+void ST7558_Sprites::takeOff(ST7558_Sprite *s) {
+  const uint8_t *from;
+  uint8_t page, lastPage, mask, n, i, *to;
+
+  if (!s->drawn) return;
+  s->drawn = false;
+
+  if (s->mode == ST7558_SPRITE_XOR) {
+    lcd.drawPageBitmap_P(s->drawnX, s->drawnY, s->drawnBitmap, s->w, s->h,
+      ST7558_ROP_XOR);
+    return;
+  }
+  if (s->saveX0 > s->saveX1) return;         // was clipped away
+  n = s->saveX1 - s->saveX0 + 1;
+  from = s->save;
+  lastPage = s->saveY1 >> 3;
+  for (page = s->saveY0 >> 3; page <= lastPage; page++) {
+    mask = 0xFF;
+    if (page == (s->saveY0 >> 3)) mask &= 0xFF << (s->saveY0 & 7);
+    if (page == lastPage)         mask &= 0xFF >> (7 - (s->saveY1 & 7));
+    to = &lcd.bits[page * lcd.stride + s->saveX0];
+    if (mask == 0xFF) {
+      memcpy(to, from, n);
+      from += n;
+    } else {
+      for (i = 0; i < n; i++, to++, from++)
+        *to = (*to & ~mask) | (*from & mask);
+    }
+  }
+  lcd.dirty(s->saveX0, s->saveY0, s->saveX1, s->saveY1);
+}
+
+// Save what the sprite covers, then draw it
+void ST7558_Sprites::putOn(ST7558_Sprite *s) {
+  int16_t x0, y0, x1, y1;
+  uint8_t *to;
+  uint8_t page, n;
+
+  if (!s->visible) return;
+
+  if (s->mode == ST7558_SPRITE_XOR) {
+    lcd.drawPageBitmap_P(s->x, s->y, s->bitmap, s->w, s->h, ST7558_ROP_XOR);
+  } else {
+    s->saveX0 = 0;
+    s->saveX1 = -1;
+    if (lcd.rotateRect(s->x, s->y, s->w, s->h, x0, y0, x1, y1)) {
+      if (x0 < lcd.clipX0) x0 = lcd.clipX0;
+      if (y0 < lcd.clipY0) y0 = lcd.clipY0;
+      if (x1 > lcd.clipX1) x1 = lcd.clipX1;
+      if (y1 > lcd.clipY1) y1 = lcd.clipY1;
+      if ((x0 <= x1) && (y0 <= y1)) {
+        s->saveX0 = x0;
+        s->saveY0 = y0;
+        s->saveX1 = x1;
+        s->saveY1 = y1;
+        n = x1 - x0 + 1;
+        to = s->save;
+        for (page = y0 >> 3; page <= (y1 >> 3); page++, to += n)
+          memcpy(to, &lcd.bits[page * lcd.stride + x0], n);
+      }
+    }
+    if (s->mask) {
+      lcd.drawPageBitmap_P(s->x, s->y, s->mask, s->w, s->h, ST7558_ROP_ANDNOT);
+      lcd.drawPageBitmap_P(s->x, s->y, s->bitmap, s->w, s->h, ST7558_ROP_OR);
+    } else {
+      lcd.drawPageBitmap_P(s->x, s->y, s->bitmap, s->w, s->h, ST7558_ROP_COPY);
+    }
+  }
+
+  s->drawn = true;
+  s->drawnX = s->x;
+  s->drawnY = s->y;
+  s->drawnBitmap = s->bitmap;
+  s->drawnMask = s->mask;
+}
@@ -0,0 +1,114 @@
+/***************************************************
+  Sprites for the ST7558 library.
+
+  A sprite is a page-format bitmap (see ST7558_Blit.h) moved over the
+  framebuffer. ST7558_Sprites keeps them in a stack and, on update(),
+  takes off and puts back only the sprites that changed plus the ones
+  stacked over them, so the work and the dirty area follow what moved.
+
+    MASKED  the mask's set pixels are cleared, then the bitmap's set
+            pixels drawn. Without a mask the sprite is an opaque
+            rectangle. The background under it is saved in a buffer of
+            ST7558_SPRITE_SAVE(w, h) bytes, from the caller or from the
+            library's pool (ST7558_Pool.h).
+    XOR     drawn and erased by inverting, no save buffer needed. XOR
+            sprites are composited over all masked ones.
+
+  Draw background changes with the sprites off (erase(), draw, update()),
+  otherwise the next restore brings back the old background.
+ ****************************************************/
+
+#ifndef _ST7558_SPRITE_H
+#define _ST7558_SPRITE_H
+
+#include "ST7558.h"
+#include "ST7558_Pool.h"
+
+#define ST7558_SPRITE_MASKED 0
+#define ST7558_SPRITE_XOR    1
+
+// Sprites an ST7558_Sprites stack holds
+#define ST7558_SPRITES_MAX 8
+
+// Save-under bytes of a w x h sprite: the pages it can span, in either
+// orientation of the display
+#define ST7558_SPRITE_SAVE_(w, h) ((w) * (((h) + 14) / 8))
+#define ST7558_SPRITE_SAVE(w, h) \
+  (ST7558_SPRITE_SAVE_(w, h) > ST7558_SPRITE_SAVE_(h, w) ? \
+   ST7558_SPRITE_SAVE_(w, h) : ST7558_SPRITE_SAVE_(h, w))
+
+class ST7558_Sprite {
+
+ public:
+  // bitmap and mask are PROGMEM page-format images of w x h pixels.
+  // Without a save buffer a masked sprite takes one from the pool.
+  ST7558_Sprite(const uint8_t *bitmap, const uint8_t *mask, int16_t w,
+    int16_t h, uint8_t *save = NULL);          // masked
+  ST7558_Sprite(const uint8_t *bitmap, int16_t w, int16_t h);   // XOR
+  ~ST7558_Sprite();
+
+  void moveTo(int16_t x, int16_t y),
+    setBitmap(const uint8_t *bitmap, const uint8_t *mask = NULL),
+    show(void),
+    hide(void);
+
+  int16_t getX(void) const { return x; }
+  int16_t getY(void) const { return y; }
+
+  // Pixel exact collisions of the sprite's shape (its mask, the bitmap of
+  // an XOR sprite, the whole box of an opaque one) with another sprite's
+  // or with dark pixels of lcd's current layer. Hidden sprites hit
+  // nothing. A sprite drawn on that layer hits itself: test with the
+  // sprites erased, or keep them on a layer of their own.
+  boolean collides(const ST7558_Sprite &other) const,
+    collides(ST7558 &lcd) const;
+
+ private:
+  friend class ST7558_Sprites;
+
+  // A copy would free the same pool block twice
+  ST7558_Sprite(const ST7558_Sprite &);
+  ST7558_Sprite &operator=(const ST7558_Sprite &);
+
+  boolean changed(void) const;
+  const uint8_t *shape(void) const;
+
+  const uint8_t *bitmap, *mask;
+  uint8_t *save;
+  int16_t x, y, w, h;
+  uint8_t mode;
+  boolean visible, pooled;
+
+  // What is on the framebuffer now
+  const uint8_t *drawnBitmap, *drawnMask;
+  int16_t drawnX, drawnY;
+  boolean drawn;
+  int16_t saveX0, saveY0,      // saved area, controller space, inclusive
+    saveX1, saveY1;
+};
+
+class ST7558_Sprites {
+
+ public:
+  ST7558_Sprites(ST7558 &lcd);
+
+  // Stack a sprite over the ones added before; false when full or when a
+  // masked sprite got no save buffer
+  boolean add(ST7558_Sprite &s);
+
+  void
+    update(void),   // Redraw what changed and mark it dirty
+    erase(void);    // Take every sprite off, update() puts them back
+
+ private:
+  void takeOff(ST7558_Sprite *s),
+    putOn(ST7558_Sprite *s);
+  boolean overlaps(const ST7558_Sprite *a, const ST7558_Sprite *b) const;
+  uint8_t depth(uint8_t i) const;
+
+  ST7558 &lcd;
+  ST7558_Sprite *sprite[ST7558_SPRITES_MAX];
+  uint8_t count;
+};
+
+#endif
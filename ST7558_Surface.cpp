@@ -0,0 +1,730 @@
+/***************************************************
+  Page-format drawing surfaces for the ST7558 library.
+ ****************************************************/
+
+#ifdef __AVR__
+ #include <avr/pgmspace.h>
+#elif defined(ESP8266)
+ #include <pgmspace.h>
+#endif
+
+#ifndef _BV
+  #define _BV(x) (1 << (x))
+#endif
+
+#include <stdlib.h>
+#include "ST7558_Surface.h"
+
+ST7558_Surface::ST7558_Surface(int16_t w, int16_t h, uint8_t *bits,
+  uint8_t stride)
+  : Core_GFX_T<ST7558_Surface>(w, h), bits(bits), stride(stride),
+    patterned(false)
+{
+  clipChanged();
+}
+
+// Keep a buffer space copy of the clip rectangle for the rasterisers.
+// Without a buffer nothing is drawable, whatever clip rectangle is set.
+void ST7558_Surface::clipChanged(void) {
+  if (!bits) {
+    clip_x0 = clip_y0 = 0;
+    clip_x1 = clip_y1 = -1;
+  }
+  clipX0 = clip_x0;
+  clipY0 = clip_y0;
+  clipX1 = clip_x1;
+  clipY1 = clip_y1;
+  rotateXY(clipX0, clipY0);
+  rotateXY(clipX1, clipY1);
+  if ((clip_x0 > clip_x1) || (clip_y0 > clip_y1)) {
+    clipX0 = clipY0 = 0;      // nothing drawable
+    clipX1 = clipY1 = -1;
+    return;
+  }
+  if (clipX0 > clipX1) swap(clipX0, clipX1);
+  if (clipY0 > clipY1) swap(clipY0, clipY1);
+}
+
+// Local (origin relative) coordinates to buffer space
+void ST7558_Surface::panelXY(int16_t &x, int16_t &y) {
+  x += origin_x;
+  y += origin_y;
+  rotateXY(x, y);
+}
+
+// Dirty box of a Core_GFX_T primitive, whose pixels skip the bookkeeping
+void ST7558_Surface::markDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+  int16_t x0, y0, x1, y1;
+
+  if (!rotateRect(x, y, w, h, x0, y0, x1, y1)) return;
+  if (x0 < clipX0) x0 = clipX0;
+  if (y0 < clipY0) y0 = clipY0;
+  if (x1 > clipX1) x1 = clipX1;
+  if (y1 > clipY1) y1 = clipY1;
+  if ((x0 <= x1) && (y0 <= y1))
+    dirty(x0, y0, x1, y1);
+}
+
+void ST7558_Surface::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  x += origin_x;
+  y += origin_y;
+  if ((x < clip_x0) || (x > clip_x1) || (y < clip_y0) || (y > clip_y1)) return;
+  rotateXY(x, y);
+  setPixelRaw(x, y, color);
+  dirty(x, y, x, y);
+}
+
+// Pixels validated one by one as usual, but the dirty box is gathered in
+// locals and recorded once.
+void ST7558_Surface::drawPixels(const GFXpoint *pts, uint16_t n, uint16_t color) {
+  int16_t x, y, x0 = WIDTH, y0 = HEIGHT, x1 = -1, y1 = -1;
+
+  while (n--) {
+    x = pts->x + origin_x;
+    y = pts->y + origin_y;
+    pts++;
+    if ((x < clip_x0) || (x > clip_x1) || (y < clip_y0) || (y > clip_y1))
+      continue;
+    rotateXY(x, y);
+    setPixelRaw(x, y, color);
+    if (x < x0) x0 = x;
+    if (x > x1) x1 = x;
+    if (y < y0) y0 = y;
+    if (y > y1) y1 = y;
+  }
+  if (x1 >= 0)
+    dirty(x0, y0, x1, y1);
+}
+
+// Bresenham straight into the buffer. The line is rotated and clipped
+// once up front: the pixel range that lies inside the clip rectangle is
+// solved for directly from the error term, so the clipped line plots exactly
+// the pixels the unclipped one would and clipped parts cost nothing.
+//
+// Rows (x major) are walked as a moving column pointer with a fixed bit mask,
+// columns (y major) collect their run of bits in one byte and store it with a
+// single masked write per page.
+void ST7558_Surface::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  uint16_t color) {
+
+  int16_t a0, b0, a1, b1, amin, amax, bmin, bmax, bstep;
+  int32_t da, db, e0, err, k, kmin, kmax, m, t;
+  uint8_t *p, mask, acc, fill;
+  boolean steep;
+
+  panelXY(x0, y0);
+  panelXY(x1, y1);
+
+  // Trivial reject, both ends beyond the same edge
+  if (((x0 < clipX0) && (x1 < clipX0)) || ((x0 > clipX1) && (x1 > clipX1)) ||
+      ((y0 < clipY0) && (y1 < clipY0)) || ((y0 > clipY1) && (y1 > clipY1)))
+    return;
+
+  // a is the major axis, b the minor one
+  steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    a0 = y0; b0 = x0; a1 = y1; b1 = x1;
+    amin = clipY0; amax = clipY1; bmin = clipX0; bmax = clipX1;
+  } else {
+    a0 = x0; b0 = y0; a1 = x1; b1 = y1;
+    amin = clipX0; amax = clipX1; bmin = clipY0; bmax = clipY1;
+  }
+  if (a0 > a1) {
+    swap(a0, a1);
+    swap(b0, b1);
+  }
+
+  da = (int32_t)a1 - a0;
+  db = abs((int32_t)b1 - b0);
+  bstep = (b0 < b1) ? 1 : -1;
+  e0 = da / 2;
+
+  // Step k plots (a0 + k, b0 + bstep * m(k)), m(k) = ceil((k*db - e0) / da)
+  // clamped at 0. Clip k against both axes.
+  kmin = (a0 < amin) ? (int32_t)amin - a0 : 0;
+  kmax = (a1 > amax) ? (int32_t)amax - a0 : da;
+  if (db) {
+    t = (bstep > 0) ? (int32_t)bmin - b0 : (int32_t)b0 - bmax;   // m(k) >= t
+    if (t > 0) {
+      k = ((t - 1) * da + e0) / db + 1;
+      if (k > kmin) kmin = k;
+    }
+    t = (bstep > 0) ? (int32_t)bmax - b0 : (int32_t)b0 - bmin;   // m(k) <= t
+    if (t < 0) return;
+    k = (t * da + e0) / db;
+    if (k < kmax) kmax = k;
+  } else if ((b0 < bmin) || (b0 > bmax)) {
+    return;
+  }
+  if (kmin > kmax) return;
+
+  // Error term at the first visible pixel
+  m = kmin * db - e0;
+  m = (m > 0) ? (m + da - 1) / da : 0;
+  err = e0 - kmin * db + m * da;
+  a0 += kmin;
+  b0 += bstep * m;
+
+  // Last visible pixel, for the dirty box
+  t = kmax * db - e0;
+  t = (t > 0) ? (t + da - 1) / da : 0;
+  a1 = a0 + (kmax - kmin);
+  b1 = b0 + bstep * (t - m);
+  if (steep)
+    dirty(min(b0, b1), a0, max(b0, b1), a1);
+  else
+    dirty(a0, min(b0, b1), a1, max(b0, b1));
+
+  fill = color ? 0x00 : 0xFF;
+  k = kmax - kmin + 1;
+
+  // Outlines of pattern fills: a pixel at a time, each column's own byte
+  if (patterned) {
+    while (k--) {
+      x0 = steep ? b0 : a0;
+      y0 = steep ? a0 : b0;
+      p = &bits[(y0 >> 3) * stride + x0];
+      mask = _BV(y0 & 7) & patternInk[x0 & 7];
+      *p = (*p & ~mask) | (mask & patternFill[x0 & 7]);
+      a0++;
+      err -= db;
+      if (err < 0) {
+        err += da;
+        b0 += bstep;
+      }
+    }
+    return;
+  }
+
+  if (!steep) {
+    p = &bits[(b0 >> 3) * stride + a0];
+    mask = _BV(b0 & 7);
+    while (k--) {
+      *p = (*p & ~mask) | (mask & fill);
+      p++;
+      err -= db;
+      if (err < 0) {
+        err += da;
+        if (bstep > 0) {
+          mask <<= 1;
+          if (!mask) { mask = 0x01; p += stride; }
+        } else {
+          mask >>= 1;
+          if (!mask) { mask = 0x80; p -= stride; }
+        }
+      }
+    }
+  } else {
+    p = &bits[(a0 >> 3) * stride + b0];
+    mask = _BV(a0 & 7);
+    acc = 0;
+    while (k--) {
+      acc |= mask;
+      mask <<= 1;
+      err -= db;
+      if (err < 0) {
+        err += da;
+        *p = (*p & ~acc) | (acc & fill);
+        acc = 0;
+        p += bstep;
+      }
+      if (!mask) {
+        if (acc) {
+          *p = (*p & ~acc) | (acc & fill);
+          acc = 0;
+        }
+        mask = 0x01;
+        p += stride;
+      }
+    }
+    if (acc)
+      *p = (*p & ~acc) | (acc & fill);
+  }
+}
+
+void ST7558_Surface::drawPageBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+  int16_t w, int16_t h, uint8_t rop) {
+  blitPage(x, y, bitmap, w, h, rop, false);
+}
+
+void ST7558_Surface::drawPageBitmap_P(int16_t x, int16_t y, const uint8_t *bitmap,
+  int16_t w, int16_t h, uint8_t rop) {
+  blitPage(x, y, bitmap, w, h, rop, true);
+}
+
+// Unrotated, the bitmap is already in the buffer's layout and goes in
+// a byte at a time. Rotated, it goes in 8x8 blocks turned by a bit matrix
+// transpose (see ST7558_Blit.h), still whole bytes at a time.
+void ST7558_Surface::blitPage(int16_t x, int16_t y, const uint8_t *bitmap,
+  int16_t w, int16_t h, uint8_t rop, boolean progmem) {
+
+  int16_t x0, y0, x1, y1;
+
+  if (outsideClip(x, y, w, h)) return;
+
+  if (rotation == 0) {
+    st7558_blit(bits, stride,
+      x + origin_x, y + origin_y, bitmap, w, h,
+      clipX0, clipY0, clipX1, clipY1, rop, progmem);
+  } else {
+    rotateRect(x, y, w, h, x0, y0, x1, y1);
+    st7558_blitTurned(bits, stride, x0, y0,
+      bitmap, w, h, clipX0, clipY0, clipX1, clipY1, rop, progmem, rotation);
+  }
+  markDirty(x, y, w, h);
+}
+
+// Packed bitmaps (ST7558_Pack.h) decode as they are drawn, no buffer
+void ST7558_Surface::drawPackedBitmap(int16_t x, int16_t y, const uint8_t *packed,
+  uint8_t rop) {
+
+  int16_t w = pgm_read_byte(packed), h = pgm_read_byte(packed + 1);
+  int16_t x0, y0, x1, y1, bc, br;
+  uint8_t block[8], cw, i;
+
+  if (outsideClip(x, y, w, h)) return;
+
+  if (rotation == 0) {
+    st7558_unpack(bits, stride,
+      x + origin_x, y + origin_y, packed,
+      clipX0, clipY0, clipX1, clipY1, rop);
+  } else {
+    ST7558_Unpacker u(packed);
+
+    // The stream runs column by column along each page, so every 8 bytes
+    // make the next block
+    rotateRect(x, y, w, h, x0, y0, x1, y1);
+    for (br = 0; br < h; br += 8) {
+      for (bc = 0; bc < w; bc += 8) {
+        cw = (w - bc < 8) ? w - bc : 8;
+        for (i = 0; i < cw; i++)
+          block[i] = u.next();
+        st7558_blitTurnedBlock(bits, stride,
+          x0, y0, w, h, bc, br, block, cw,
+          clipX0, clipY0, clipX1, clipY1, rop, rotation);
+      }
+    }
+  }
+  markDirty(x, y, w, h);
+}
+
+// Font glyphs are 5 page-format columns, so the plain size goes through the
+// blitter in any rotation; vertical text lands as whole bytes too. Scaled
+// glyphs are drawn pixel by pixel.
+void ST7558_Surface::drawGlyph(int16_t x, int16_t y, uint16_t glyph, uint16_t color,
+  uint16_t bg, uint8_t size) {
+
+  const uint8_t *bitmap;
+
+  if (size != 1) {
+    Core_GFX_T<ST7558_Surface>::drawGlyph(x, y, glyph, color, bg, size);
+    return;
+  }
+  bitmap = font->bitmap + glyph * GFX_GLYPH_WIDTH;
+  if (bg == color) {
+    blitPage(x, y, bitmap, GFX_GLYPH_WIDTH, 8,
+      color ? ST7558_ROP_ANDNOT : ST7558_ROP_OR, true);
+  } else if (!color) {
+    blitPage(x, y, bitmap, GFX_GLYPH_WIDTH, 8, ST7558_ROP_COPY, true);
+  } else {
+    fillRect(x, y, GFX_GLYPH_WIDTH, 8, bg);
+    blitPage(x, y, bitmap, GFX_GLYPH_WIDTH, 8, ST7558_ROP_ANDNOT, true);
+  }
+}
+
+void ST7558_Surface::invertRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+  int16_t x0, y0, x1, y1;
+
+  if (!rotateRect(x, y, w, h, x0, y0, x1, y1)) return;
+  if (x0 < clipX0) x0 = clipX0;
+  if (y0 < clipY0) y0 = clipY0;
+  if (x1 > clipX1) x1 = clipX1;
+  if (y1 > clipY1) y1 = clipY1;
+  if ((x0 > x1) || (y0 > y1)) return;
+  st7558_regionFill(bits, stride, x0, y0, x1, y1,
+    ST7558_ROP_XOR);
+  dirty(x0, y0, x1, y1);
+}
+
+// Both areas rotate the same way, so the copy keeps its orientation. The
+// destination is clipped, the source kept on the surface, each trimmed by
+// what the other loses.
+void ST7558_Surface::copyRect(int16_t sx, int16_t sy, int16_t w, int16_t h,
+  int16_t dx, int16_t dy, uint8_t rop) {
+
+  int16_t x0, y0, x1, y1, d0, e0, d1, e1, t;
+
+  if (!rotateRect(sx, sy, w, h, x0, y0, x1, y1)) return;
+  rotateRect(dx, dy, w, h, d0, e0, d1, e1);
+  if ((t = max(clipX0 - d0, -x0)) > 0) { x0 += t; d0 += t; }
+  if ((t = max(clipY0 - e0, -y0)) > 0) { y0 += t; e0 += t; }
+  if ((t = max(d1 - clipX1, x1 - (WIDTH - 1))) > 0)  x1 -= t;
+  if ((t = max(e1 - clipY1, y1 - (HEIGHT - 1))) > 0) y1 -= t;
+  if ((x0 > x1) || (y0 > y1)) return;
+  st7558_regionCopy(bits, stride, d0, e0,
+    bits, stride, x0, y0, x1, y1, rop);
+  dirty(d0, e0, d0 + x1 - x0, e0 + y1 - y0);
+}
+
+// Display rotations turn both areas alike, so the turn is the same in
+// buffer space. Trimming the source to the surface moves the turned
+// area's corner by the trim on the side that turns to its top left.
+void ST7558_Surface::turnRect(int16_t sx, int16_t sy, int16_t w, int16_t h,
+  int16_t dx, int16_t dy, uint8_t turns, uint8_t rop) {
+
+  int16_t x0, y0, x1, y1, d0, e0, d1, e1, l, t, r, b;
+
+  turns &= 3;
+  if (!rotateRect(sx, sy, w, h, x0, y0, x1, y1)) return;
+  if (turns & 1) swap(w, h);
+  rotateRect(dx, dy, w, h, d0, e0, d1, e1);
+  l = max(-x0, 0);
+  t = max(-y0, 0);
+  r = max(x1 - (WIDTH - 1), 0);
+  b = max(y1 - (HEIGHT - 1), 0);
+  x0 += l; y0 += t; x1 -= r; y1 -= b;
+  if ((x0 > x1) || (y0 > y1)) return;
+  switch (turns) {
+    case 0: d0 += l; e0 += t; break;
+    case 1: d0 += t; e0 += r; break;
+    case 2: d0 += r; e0 += b; break;
+    case 3: d0 += b; e0 += l; break;
+  }
+  w = x1 - x0 + 1;
+  h = y1 - y0 + 1;
+  if (turns & 1) swap(w, h);
+  d1 = min(d0 + w - 1, clipX1);
+  e1 = min(e0 + h - 1, clipY1);
+  if ((max(d0, clipX0) > d1) || (max(e0, clipY0) > e1)) return;
+  st7558_regionRotate(bits, stride, d0, e0,
+    bits, stride, x0, y0, x1, y1,
+    clipX0, clipY0, clipX1, clipY1, rop, turns);
+  dirty(max(d0, clipX0), max(e0, clipY0), d1, e1);
+}
+
+void ST7558_Surface::scrollRect(int16_t x, int16_t y, int16_t w, int16_t h,
+  int16_t dx, int16_t dy) {
+
+  int16_t x0, y0, x1, y1, t;
+
+  if (!rotateRect(x, y, w, h, x0, y0, x1, y1)) return;
+  if (x0 < clipX0) x0 = clipX0;
+  if (y0 < clipY0) y0 = clipY0;
+  if (x1 > clipX1) x1 = clipX1;
+  if (y1 > clipY1) y1 = clipY1;
+  if ((x0 > x1) || (y0 > y1)) return;
+
+  // The move in buffer space
+  switch (rotation) {
+    case 1: t = dx; dx = dy;  dy = -t; break;
+    case 2: dx = -dx; dy = -dy;        break;
+    case 3: t = dx; dx = -dy; dy = t;  break;
+  }
+  st7558_regionShift(bits, stride, x0, y0, x1, y1, dx, dy);
+  dirty(x0, y0, x1, y1);
+}
+
+uint16_t ST7558_Surface::countPixels(int16_t x, int16_t y, int16_t w, int16_t h) {
+  int16_t x0, y0, x1, y1;
+
+  if (!rotateRect(x, y, w, h, x0, y0, x1, y1)) return 0;
+  if (x0 < 0) x0 = 0;
+  if (y0 < 0) y0 = 0;
+  if (x1 > WIDTH - 1)  x1 = WIDTH - 1;
+  if (y1 > HEIGHT - 1) y1 = HEIGHT - 1;
+  return st7558_regionCount(bits, stride, x0, y0, x1, y1);
+}
+
+boolean ST7558_Surface::anyPixel(int16_t x, int16_t y, int16_t w, int16_t h) {
+  int16_t x0, y0, x1, y1;
+
+  if (!rotateRect(x, y, w, h, x0, y0, x1, y1)) return false;
+  if (x0 < 0) x0 = 0;
+  if (y0 < 0) y0 = 0;
+  if (x1 > WIDTH - 1)  x1 = WIDTH - 1;
+  if (y1 > HEIGHT - 1) y1 = HEIGHT - 1;
+  return st7558_regionAny(bits, stride, x0, y0, x1, y1);
+}
+
+boolean ST7558_Surface::hitBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+  int16_t w, int16_t h) {
+  return hitPage(x, y, bitmap, w, h, false);
+}
+
+boolean ST7558_Surface::hitBitmap_P(int16_t x, int16_t y, const uint8_t *bitmap,
+  int16_t w, int16_t h) {
+  return hitPage(x, y, bitmap, w, h, true);
+}
+
+// Unrotated, the bitmap is tested where it lies. Rotated, it goes through
+// the 8x8 blocks blitPage() would draw, each turned the same way.
+boolean ST7558_Surface::hitPage(int16_t x, int16_t y, const uint8_t *bitmap,
+  int16_t w, int16_t h, boolean progmem) {
+
+  int16_t x0, y0, x1, y1, bc, br, px, py, v[4];
+  uint8_t block[8], tile[8], cw, i;
+  const uint8_t *p;
+
+  if (!rotateRect(x, y, w, h, x0, y0, x1, y1)) return false;
+  if ((rotation == 0) || !bitmap)
+    return st7558_regionOverlap(bits, stride, false,
+      x0, y0, bitmap, x1 - x0 + 1, y1 - y0 + 1, progmem,
+      0, 0, WIDTH - 1, HEIGHT - 1);
+
+  for (br = 0; br < h; br += 8) {
+    for (bc = 0; bc < w; bc += 8) {
+      cw = (w - bc < 8) ? w - bc : 8;
+      p = bitmap + (br >> 3) * w + bc;
+      for (i = 0; i < cw; i++)
+        block[i] = progmem ? pgm_read_byte(p + i) : p[i];
+      st7558_turnBlock(x0, y0, w, h, bc, br, block, cw, rotation, tile,
+        &px, &py, v);
+      if (v[0] < 0) v[0] = 0;
+      if (v[1] < 0) v[1] = 0;
+      if (v[2] > WIDTH - 1)  v[2] = WIDTH - 1;
+      if (v[3] > HEIGHT - 1) v[3] = HEIGHT - 1;
+      if (st7558_regionOverlap(bits, stride, false,
+          px, py, tile, 8, 8, false, v[0], v[1], v[2], v[3]))
+        return true;
+    }
+  }
+  return false;
+}
+
+boolean ST7558_Surface::floodFill(int16_t x, int16_t y, uint16_t color) {
+  int16_t box[4];
+  boolean complete;
+
+  panelXY(x, y);
+  complete = st7558_floodFill(bits, stride, x, y,
+    clipX0, clipY0, clipX1, clipY1, !color, box);
+  if (box[0] <= box[2])
+    dirty(box[0], box[1], box[2], box[3]);
+  return complete;
+}
+
+// Rotate a w x h rectangle into buffer space as inclusive corners
+boolean ST7558_Surface::rotateRect(int16_t x, int16_t y, int16_t w, int16_t h,
+  int16_t &x0, int16_t &y0, int16_t &x1, int16_t &y1) {
+
+  if ((w <= 0) || (h <= 0)) return false;
+  x0 = x;
+  y0 = y;
+  x1 = x + w - 1;
+  y1 = y + h - 1;
+  panelXY(x0, y0);
+  panelXY(x1, y1);
+  if (x0 > x1) swap(x0, x1);
+  if (y0 > y1) swap(y0, y1);
+  return true;
+}
+
+// Fill an area given in buffer space, clipped to the clip rectangle. The
+// span primitive every filler ends in: one masked write per page and
+// column, plain byte stores for the pages it covers completely. A pattern
+// costs a table lookup per byte instead of the memset().
+void ST7558_Surface::fillArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  uint16_t color) {
+
+  uint8_t page, lastPage, mask, fill, w, i, c, m, *p;
+
+  if (x0 < clipX0) x0 = clipX0;
+  if (y0 < clipY0) y0 = clipY0;
+  if (x1 > clipX1) x1 = clipX1;
+  if (y1 > clipY1) y1 = clipY1;
+  if ((x0 > x1) || (y0 > y1)) return;
+
+  dirty(x0, y0, x1, y1);
+
+  fill = color ? 0x00 : 0xFF;
+  w = x1 - x0 + 1;
+  page = y0 >> 3;
+  lastPage = y1 >> 3;
+  mask = 0xFF << (y0 & 7);
+  for (;;) {
+    if (page == lastPage)
+      mask &= 0xFF >> (7 - (y1 & 7));
+    p = &bits[page * stride + x0];
+    if (patterned) {
+      for (i = 0; i < w; i++, p++) {
+        c = (x0 + i) & 7;
+        m = mask & patternInk[c];
+        *p = (*p & ~m) | (m & patternFill[c]);
+      }
+    } else if (mask == 0xFF) {
+      memset(p, fill, w);
+    } else {
+      for (i = w; i; i--, p++)
+        *p = (*p & ~mask) | (mask & fill);
+    }
+    if (page == lastPage) break;
+    page++;
+    mask = 0xFF;
+  }
+}
+
+// Rounded box in buffer space, filled as vertical spans. Same shape as
+// Core_GFX::fillRoundRect(), but every column is written once: the corner
+// columns reached through y only get their span once it stopped growing.
+void ST7558_Surface::fillRoundArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  int16_t r, uint16_t color) {
+
+  int16_t f, ddF_x, ddF_y, x, y, cl, cr, cy, delta;
+
+  fillArea(x0 + r, y0, x1 - r, y1, color);
+
+  f     = 1 - r;
+  ddF_x = 1;
+  ddF_y = -2 * r;
+  x     = 0;
+  y     = r;
+  cl    = x0 + r;
+  cr    = x1 - r;
+  cy    = y0 + r;
+  delta = y1 - y0 - 2 * r;
+
+  while (x < y) {
+    if (f >= 0) {
+      fillArea(cr + y, cy - x, cr + y, cy + x + delta, color);
+      fillArea(cl - y, cy - x, cl - y, cy + x + delta, color);
+      y--;
+      ddF_y += 2;
+      f     += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f     += ddF_x;
+
+    fillArea(cr + x, cy - y, cr + x, cy + y + delta, color);
+    fillArea(cl - x, cy - y, cl - x, cy + y + delta, color);
+  }
+  if (r > 0) {
+    fillArea(cr + y, cy - x, cr + y, cy + x + delta, color);
+    fillArea(cl - y, cy - x, cl - y, cy + x + delta, color);
+  }
+}
+
+void ST7558_Surface::drawFastVLine(int16_t x, int16_t y, int16_t h,  uint16_t color){
+  int16_t x0, y0, x1, y1;
+
+  if (rotateRect(x, y, 1, h, x0, y0, x1, y1))
+    fillArea(x0, y0, x1, y1, color);
+}
+
+void ST7558_Surface::drawFastHLine(int16_t x, int16_t y, int16_t w,  uint16_t color){
+  int16_t x0, y0, x1, y1;
+
+  if (rotateRect(x, y, w, 1, x0, y0, x1, y1))
+    fillArea(x0, y0, x1, y1, color);
+}
+
+void ST7558_Surface::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+  uint16_t color) {
+  int16_t x0, y0, x1, y1;
+
+  if (rotateRect(x, y, w, h, x0, y0, x1, y1))
+    fillArea(x0, y0, x1, y1, color);
+}
+
+void ST7558_Surface::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+
+  panelXY(x0, y0);
+
+  // Tiny radii, e.g. vertex dots, skip the midpoint loop
+  if (r <= 0) {
+    fillArea(x0, y0, x0, y0, color);
+  } else if (r == 1) {
+    fillArea(x0, y0 - 1, x0, y0 + 1, color);
+    fillArea(x0 - 1, y0, x0 + 1, y0, color);
+  } else {
+    fillRoundArea(x0 - r, y0 - r, x0 + r, y0 + r, r, color);
+  }
+}
+
+void ST7558_Surface::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
+  int16_t r, uint16_t color) {
+  int16_t x0, y0, x1, y1;
+
+  if (!rotateRect(x, y, w, h, x0, y0, x1, y1)) return;
+  if (r > (x1 - x0) / 2) r = (x1 - x0) / 2;
+  if (r > (y1 - y0) / 2) r = (y1 - y0) / 2;
+  fillRoundArea(x0, y0, x1, y1, r, color);
+}
+
+void ST7558_Surface::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  int16_t x2, int16_t y2, uint16_t color) {
+  GFXpoint pts[3] = { { x0, y0 }, { x1, y1 }, { x2, y2 } };
+
+  fillPolygon(pts, 3, color);
+}
+
+// Polygons are scanned along the buffer's columns, so every span is a
+// vertical run of page bytes.
+void ST7558_Surface::fillPolygon(const GFXpoint *pts, uint8_t n, uint16_t color) {
+  GFXpoint phys[GFX_POLYGON_MAX];
+  int16_t x, a, b;
+  uint8_t i;
+
+  if (n > GFX_POLYGON_MAX) return;
+  for (i = 0; i < n; i++) {
+    phys[i] = pts[i];
+    panelXY(phys[i].x, phys[i].y);
+  }
+
+  Core_GFX_PolygonScan scan(phys, n, true, clipX0, clipX1);
+  while (scan.nextLine(x))
+    while (scan.nextSpan(a, b))
+      fillArea(x, a, x, b, color);
+  drawPolygon(pts, n, color);
+}
+
+// Pattern columns for the rotation, and what each pattern pixel becomes:
+// set ones color, clear ones bg, only the set ones for a stipple.
+void ST7558_Surface::setPattern(const uint8_t *pattern, uint16_t color, uint16_t bg) {
+  uint8_t cols[8], i;
+
+  st7558_patternColumns(pattern, rotation, WIDTH, HEIGHT, cols);
+  for (i = 0; i < 8; i++) {
+    if (bg == color) {
+      patternInk[i] = cols[i];
+      patternFill[i] = color ? 0x00 : 0xFF;
+    } else {
+      patternInk[i] = 0xFF;
+      patternFill[i] = (color ? 0x00 : cols[i]) | (bg ? 0x00 : ~cols[i]);
+    }
+  }
+  patterned = true;
+}
+
+void ST7558_Surface::fillRectPattern(int16_t x, int16_t y, int16_t w, int16_t h,
+  const uint8_t *pattern, uint16_t color, uint16_t bg) {
+
+  setPattern(pattern, color, bg);
+  fillRect(x, y, w, h, color);
+  patterned = false;
+}
+
+void ST7558_Surface::fillCirclePattern(int16_t x0, int16_t y0, int16_t r,
+  const uint8_t *pattern, uint16_t color, uint16_t bg) {
+
+  setPattern(pattern, color, bg);
+  fillCircle(x0, y0, r, color);
+  patterned = false;
+}
+
+void ST7558_Surface::fillTrianglePattern(int16_t x0, int16_t y0, int16_t x1,
+  int16_t y1, int16_t x2, int16_t y2, const uint8_t *pattern,
+  uint16_t color, uint16_t bg) {
+
+  GFXpoint pts[3] = { { x0, y0 }, { x1, y1 }, { x2, y2 } };
+
+  fillPolygonPattern(pts, 3, pattern, color, bg);
+}
+
+void ST7558_Surface::fillPolygonPattern(const GFXpoint *pts, uint8_t n,
+  const uint8_t *pattern, uint16_t color, uint16_t bg) {
+
+  setPattern(pattern, color, bg);
+  fillPolygon(pts, n, color);
+  patterned = false;
+}
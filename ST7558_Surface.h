@@ -0,0 +1,183 @@
+/***************************************************
+  Page-format drawing surfaces for the ST7558 library.
+
+  ST7558_Surface draws on a page-format buffer (see ST7558_Blit.h):
+  'stride' bytes per page, LSB on top, a set bit dark. It keeps the clip
+  rectangle in the buffer's own (unrotated) space and has the fast paths
+  written against it: line, span and polygon rasterisers, pattern fills,
+  page bitmap and glyph blits, region operations and flood fill. The
+  display (ST7558) and off-screen canvases (ST7558_Canvas) are both
+  surfaces, over the framebuffer and over a canvas' bits.
+
+  Every primitive reports the area it drew through dirty(), in buffer
+  space and clipped. A surface without partial updates ignores it; the
+  display records it for flush().
+ ****************************************************/
+
+#ifndef _ST7558_SURFACE_H
+#define _ST7558_SURFACE_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+  #include "Arduino.h"
+#else
+  #include "WProgram.h"
+#endif
+#include <Core_GFX.h>
+#include <Core_GFX_T.h>
+#include "ST7558_Blit.h"
+#include "ST7558_Pack.h"
+#include "ST7558_Region.h"
+#include "ST7558_Fill.h"
+#include "ST7558_Pattern.h"
+
+class ST7558_Surface : public Core_GFX_T<ST7558_Surface> {
+
+ public:
+  // w x h pixels in bits, stride bytes per page
+  ST7558_Surface(int16_t w, int16_t h, uint8_t *bits, uint8_t stride);
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color),
+    drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color),
+    drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color),
+    drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color),
+    fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color),
+    fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color),
+    fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+      int16_t x2, int16_t y2, uint16_t color),
+    fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
+      int16_t r, uint16_t color),
+    fillPolygon(const GFXpoint *pts, uint8_t n, uint16_t color),
+    drawPixels(const GFXpoint *pts, uint16_t n, uint16_t color);
+
+  // Page-format bitmap (see ST7558_Blit.h) combined with raster op rop,
+  // from RAM, or from PROGMEM with the _P version.
+  void drawPageBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+         int16_t w, int16_t h, uint8_t rop = ST7558_ROP_COPY),
+       drawPageBitmap_P(int16_t x, int16_t y, const uint8_t *bitmap,
+         int16_t w, int16_t h, uint8_t rop = ST7558_ROP_COPY),
+       // Packed bitmap (see ST7558_Pack.h), PROGMEM
+       drawPackedBitmap(int16_t x, int16_t y, const uint8_t *packed,
+         uint8_t rop = ST7558_ROP_COPY),
+       drawGlyph(int16_t x, int16_t y, uint16_t glyph, uint16_t color,
+         uint16_t bg, uint8_t size);
+
+  // Region operations (see ST7558_Region.h), clipped like any drawing.
+  // copyRect() combines a w x h area at (sx, sy) into (dx, dy), overlap
+  // allowed; scrollRect() moves an area's contents by (dx, dy) within it
+  // and clears what that uncovers. turnRect() is copyRect() with the area
+  // turned 'turns' quarter turns counterclockwise, (dx, dy) being the top
+  // left corner of the turned area; the two must not overlap.
+  void invertRect(int16_t x, int16_t y, int16_t w, int16_t h),
+       copyRect(int16_t sx, int16_t sy, int16_t w, int16_t h,
+         int16_t dx, int16_t dy, uint8_t rop = ST7558_ROP_COPY),
+       turnRect(int16_t sx, int16_t sy, int16_t w, int16_t h,
+         int16_t dx, int16_t dy, uint8_t turns,
+         uint8_t rop = ST7558_ROP_COPY),
+       scrollRect(int16_t x, int16_t y, int16_t w, int16_t h,
+         int16_t dx, int16_t dy);
+  // Dark pixels in the area, on the surface
+  uint16_t countPixels(int16_t x, int16_t y, int16_t w, int16_t h);
+  // Hit tests, on the surface, done at the first dark pixel found:
+  // anyPixel() for one in the area, hitBitmap() for one under a dark pixel
+  // of a page-format bitmap (a mask) at (x, y). The bitmap is in RAM, or
+  // in PROGMEM for hitBitmap_P(); NULL is a solid w x h box.
+  boolean anyPixel(int16_t x, int16_t y, int16_t w, int16_t h),
+          hitBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+            int16_t w, int16_t h),
+          hitBitmap_P(int16_t x, int16_t y, const uint8_t *bitmap,
+            int16_t w, int16_t h);
+  // Fill the area of like pixels around (x, y) up to its outline or the
+  // clip rectangle (see ST7558_Fill.h); false if part of it was left
+  boolean floodFill(int16_t x, int16_t y, uint16_t color);
+
+  // Pattern fills (see ST7558_Pattern.h): the pattern's set pixels in
+  // color, the others in bg, or left alone when bg == color. Same shapes,
+  // clipping and speed as the solid fills.
+  void fillRectPattern(int16_t x, int16_t y, int16_t w, int16_t h,
+         const uint8_t *pattern, uint16_t color, uint16_t bg),
+       fillCirclePattern(int16_t x0, int16_t y0, int16_t r,
+         const uint8_t *pattern, uint16_t color, uint16_t bg),
+       fillTrianglePattern(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+         int16_t x2, int16_t y2, const uint8_t *pattern, uint16_t color,
+         uint16_t bg),
+       fillPolygonPattern(const GFXpoint *pts, uint8_t n,
+         const uint8_t *pattern, uint16_t color, uint16_t bg);
+
+  // Pixel sink of the Core_GFX_T primitives, inlined into their loops
+  void writePixel(int16_t x, int16_t y, uint16_t color) {
+    x += origin_x;
+    y += origin_y;
+    if ((x < clip_x0) || (x > clip_x1) || (y < clip_y0) || (y > clip_y1)) return;
+    rotateXY(x, y);
+    setPixelRaw(x, y, color);
+  }
+  void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+
+  // Unchecked setters in buffer space (x below the stride, y inside the
+  // buffer's pages): no clipping, no rotation, no dirty bookkeeping. On
+  // the display, meant for code between startWrite() and endWrite(),
+  // which marks the clip rectangle dirty once.
+  void setPixelRaw(uint8_t x, uint8_t y, uint16_t color) {
+    if (!color)
+      bits[(y >> 3) * stride + x] |= (1 << (y & 7));
+    else
+      bits[(y >> 3) * stride + x] &= ~(1 << (y & 7));
+  }
+  // Bits set in mask take the color, the rest of the byte is kept
+  void setByteRaw(uint8_t x, uint8_t page, uint8_t mask, uint16_t color) {
+    uint8_t *p = &bits[page * stride + x];
+
+    *p = color ? (*p & ~mask) : (*p | mask);
+  }
+
+ protected:
+  void clipChanged(void);
+
+  // Area a primitive drew, buffer space, inclusive and inside the clip
+  // rectangle
+  virtual void dirty(int16_t, int16_t, int16_t, int16_t) { }
+
+  void panelXY(int16_t &x, int16_t &y),
+    fillArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color),
+    fillRoundArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+      int16_t r, uint16_t color),
+    setPattern(const uint8_t *pattern, uint16_t color, uint16_t bg),
+    blitPage(int16_t x, int16_t y, const uint8_t *bitmap,
+      int16_t w, int16_t h, uint8_t rop, boolean progmem);
+  boolean rotateRect(int16_t x, int16_t y, int16_t w, int16_t h,
+      int16_t &x0, int16_t &y0, int16_t &x1, int16_t &y1),
+    hitPage(int16_t x, int16_t y, const uint8_t *bitmap,
+      int16_t w, int16_t h, boolean progmem);
+
+  uint8_t *bits;                            // Drawing target
+  uint8_t stride;                           // Bytes per page
+  int16_t clipX0, clipY0, clipX1, clipY1;   // Clip rectangle, buffer space
+  // While a pattern fill runs, fillArea() and drawLine() store column x
+  // as bits patternInk[x & 7] of patternFill[x & 7]
+  uint8_t patternInk[8], patternFill[8];
+  boolean patterned;
+
+  // Rotated (logical) coordinates to the buffer's own
+  void rotateXY(int16_t &x, int16_t &y) {
+    int16_t t;
+
+    switch (rotation) {
+      case 1:
+        t = x;
+        x = y;
+        y = HEIGHT - 1 - t;
+        break;
+      case 2:
+        x = WIDTH - 1 - x;
+        y = HEIGHT - 1 - y;
+        break;
+      case 3:
+        t = x;
+        x = WIDTH - 1 - y;
+        y = t;
+        break;
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,107 @@
+/***************************************************
+  Tilemaps for the ST7558 library.
+ ****************************************************/
+
+#include "ST7558_Tilemap.h"
+
+ST7558_Tilemap::ST7558_Tilemap(ST7558 &lcd, const uint8_t *tiles,
+  uint8_t *map, uint8_t mapW, uint8_t mapH,
+  int16_t x, int16_t y, int16_t w, int16_t h)
+  : lcd(lcd), tiles(tiles), map(map), mapW(mapW), mapH(mapH),
+    x(x), y(y), w(w), h(h), scrollX(0), scrollY(0), drawnX(0), drawnY(0),
+    changes(0), full(true)
+{
+}
+
+uint8_t ST7558_Tilemap::getTile(uint8_t col, uint8_t row) const {
+  if ((col >= mapW) || (row >= mapH)) return 0;
+  return map[row * mapW + col];
+}
+
+void ST7558_Tilemap::setTile(uint8_t col, uint8_t row, uint8_t tile) {
+  uint8_t *p;
+
+  if ((col >= mapW) || (row >= mapH)) return;
+  p = &map[row * mapW + col];
+  if (*p == tile) return;
+  *p = tile;
+  if (full) return;
+  if (changes < ST7558_TILEMAP_CHANGES) {
+    change[changes].col = col;
+    change[changes].row = row;
+    changes++;
+  } else {
+    full = true;
+  }
+}
+
+void ST7558_Tilemap::scrollTo(int16_t sx, int16_t sy) {
+  scrollX = sx;
+  scrollY = sy;
+}
+
+void ST7558_Tilemap::invalidate(void) {
+  full = true;
+}
+
+// Changed tiles go in where the display still has them, then the visible
+// part of the window scrolls and the strips it uncovers are drawn at the
+// new position.
+void ST7558_Tilemap::draw(void) {
+  int16_t dx = scrollX - drawnX, dy = scrollY - drawnY, vx, vy, vw, vh;
+  uint8_t i;
+
+  lcd.pushViewport(x, y, w, h);
+  lcd.getClipRect(vx, vy, vw, vh);
+  if (!vw || !vh) {
+    // Nothing of it on screen
+  } else if (full || (abs(dx) >= vw) || (abs(dy) >= vh)) {
+    drawArea(vx, vy, vx + vw - 1, vy + vh - 1, scrollX, scrollY);
+  } else {
+    for (i = 0; i < changes; i++)
+      drawTile(change[i].col, change[i].row, drawnX, drawnY);
+    if (dx || dy) {
+      lcd.scrollRect(vx, vy, vw, vh, -dx, -dy);
+      if (dx > 0)
+        drawArea(vx + vw - dx, vy, vx + vw - 1, vy + vh - 1, scrollX, scrollY);
+      if (dx < 0)
+        drawArea(vx, vy, vx - dx - 1, vy + vh - 1, scrollX, scrollY);
+      if (dy > 0)
+        drawArea(vx, vy + vh - dy, vx + vw - 1, vy + vh - 1, scrollX, scrollY);
+      if (dy < 0)
+        drawArea(vx, vy, vx + vw - 1, vy - dy - 1, scrollX, scrollY);
+    }
+  }
+  lcd.popViewport();
+
+  drawnX = scrollX;
+  drawnY = scrollY;
+  changes = 0;
+  full = false;
+}
+
+// The tiles under window pixels x0,y0 - x1,y1, clipped to them, the map
+// scrolled to (sx, sy)
+void ST7558_Tilemap::drawArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  int16_t sx, int16_t sy) {
+
+  int16_t col, row;
+
+  lcd.pushViewport(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+  for (row = (sy + y0) >> 3; row <= (sy + y1) >> 3; row++)
+    for (col = (sx + x0) >> 3; col <= (sx + x1) >> 3; col++)
+      drawTile(col, row, sx + x0, sy + y0);
+  lcd.popViewport();
+}
+
+// Tile col, row with the map scrolled to (sx, sy) in the current viewport
+void ST7558_Tilemap::drawTile(int16_t col, int16_t row,
+  int16_t sx, int16_t sy) {
+  int16_t tx = col * 8 - sx, ty = row * 8 - sy;
+
+  if ((col >= 0) && (col < mapW) && (row >= 0) && (row < mapH))
+    lcd.drawPageBitmap_P(tx, ty, tiles + map[row * mapW + col] * 8, 8, 8,
+      ST7558_ROP_COPY);
+  else
+    lcd.fillRect(tx, ty, 8, 8, ST7558_WHITE);
+}
@@ -0,0 +1,65 @@
+/***************************************************
+  Tilemaps for the ST7558 library.
+
+  A tile is 8x8 pixels, 8 page-format bytes (see ST7558_Blit.h): one
+  byte per column, exactly one page high. A tile sheet is a PROGMEM run
+  of them, tile n at byte n * 8. The map is a RAM array of tile indices,
+  row by row.
+
+  The map shows through a window of the display, scrolled to any pixel.
+  On a page boundary a tile goes in as 8 plain byte copies; anywhere
+  else each column is shifted across the two pages it straddles and
+  merged in. draw() only touches what changed since the last one:
+  tiles given a new index, and for a scroll, the window's contents move
+  with scrollRect() and just the strip that comes into view is drawn.
+  Tiles past the map's edges are blank. After drawing over the window,
+  or moving it with the origin, clip rectangle or rotation, invalidate()
+  it.
+
+  Memory is the map itself plus a list of ST7558_TILEMAP_CHANGES changed
+  tiles; a longer run of changes redraws the whole window.
+ ****************************************************/
+
+#ifndef _ST7558_TILEMAP_H
+#define _ST7558_TILEMAP_H
+
+#include "ST7558.h"
+
+#define ST7558_TILEMAP_CHANGES 16   // changed tiles kept between draw()s
+
+class ST7558_Tilemap {
+
+ public:
+  // map is mapW x mapH indices into tiles, shown in the w x h window at
+  // (x, y) of the display
+  ST7558_Tilemap(ST7558 &lcd, const uint8_t *tiles, uint8_t *map,
+    uint8_t mapW, uint8_t mapH, int16_t x, int16_t y, int16_t w, int16_t h);
+
+  void setTile(uint8_t col, uint8_t row, uint8_t tile),
+    scrollTo(int16_t x, int16_t y),   // map pixel at the window's top left
+    invalidate(void),                 // draw() redraws the whole window
+    draw(void);
+
+  uint8_t getTile(uint8_t col, uint8_t row) const;
+  int16_t getScrollX(void) const { return scrollX; }
+  int16_t getScrollY(void) const { return scrollY; }
+
+ private:
+  void drawArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+      int16_t sx, int16_t sy),
+    drawTile(int16_t col, int16_t row, int16_t sx, int16_t sy);
+
+  ST7558 &lcd;
+  const uint8_t *tiles;
+  uint8_t *map, mapW, mapH;
+  int16_t x, y, w, h;
+  int16_t scrollX, scrollY,       // wanted
+    drawnX, drawnY;               // on the display
+  struct {
+    uint8_t col, row;
+  } change[ST7558_TILEMAP_CHANGES];
+  uint8_t changes;
+  boolean full;                   // the whole window needs drawing
+};
+
+#endif
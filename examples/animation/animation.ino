@@ -0,0 +1,34 @@
+/***************************************************
+
+  Delta coded animation: a ball bouncing in a 48x16 box, looped at 12 fps.
+  Each frame only sends the page spans that changed.
+
+  ball.h is made from the frames directory with
+      tools/animpack.py --fps 12 --loop frames/ball*.pbm -o ball.h
+
+****************************************************/
+
+#include <ST7558.h>
+#include <ST7558_Player.h>
+#include <Wire.h>
+#include "ball.h"
+
+ST7558 lcd = ST7558();
+ST7558_Player player(lcd, ball);
+
+void setup() {
+  lcd.init();
+  lcd.setContrast(65);
+  lcd.clearDisplay();
+  lcd.setTextColor(ST7558_BLACK);
+  lcd.setCursor(0, 0);
+  lcd.print("Bouncing");
+  lcd.display();
+
+  // Columns 24 to 71, pages 3 and 4 (rows 24 to 39)
+  player.begin(24, 3);
+}
+
+void loop() {
+  player.update();
+}
@@ -0,0 +1,40 @@
+// Generated by tools/animpack.py, do not edit.
+
+#ifdef __AVR__
+ #include <avr/pgmspace.h>
+#elif defined(ESP8266)
+ #include <pgmspace.h>
+#else
+ #define PROGMEM
+#endif
+
+// 12 frames of 48x16 at 12 fps, 432 bytes
+const uint8_t ball[] PROGMEM = {
+  0x30, 0x02, 0x0c, 0x01, 0x0c, 0x00, 0x00, 0x04, 0x05, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x00,
+  0x30, 0x80, 0x80, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbe, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0xff, 0x00, 0x04, 0x09, 0xc0, 0xf0, 0xf0, 0xf8, 0xf8, 0xf8, 0xf8, 0xf0, 0xe0, 0x01, 0x02,
+  0x0b, 0x80, 0x80, 0x81, 0x87, 0x87, 0x8f, 0x8f, 0x8f, 0x8f, 0x87, 0x83, 0xff, 0x00, 0x04, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xfe, 0x38,
+  0x01, 0x04, 0x0d, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81,
+  0xff, 0x00, 0x0b, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x3e, 0x7f, 0xff,
+  0xff, 0xff, 0xff, 0x7f, 0x3e, 0x01, 0x0d, 0x04, 0x80, 0x80, 0x80, 0x80, 0xff, 0x00, 0x13, 0x12,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0xfe, 0xfe, 0xff, 0xff, 0xff, 0xff,
+  0xfe, 0x7c, 0x01, 0x1f, 0x04, 0x81, 0x81, 0x81, 0x81, 0xff, 0x00, 0x1c, 0x10, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xe0, 0xf0, 0xf8, 0xf8, 0xf8, 0xf8, 0xf0, 0xf0, 0xc0, 0x01, 0x1f, 0x0d,
+  0x80, 0x80, 0x80, 0x80, 0x83, 0x87, 0x8f, 0x8f, 0x8f, 0x8f, 0x87, 0x87, 0x81, 0xff, 0x00, 0x23,
+  0x09, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x23, 0x0b, 0x80, 0x80, 0xbe,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbe, 0xff, 0x00, 0x23, 0x09, 0xe0, 0xf0, 0xf8, 0xf8,
+  0xf8, 0xf8, 0xf0, 0xf0, 0xc0, 0x01, 0x23, 0x0b, 0x83, 0x87, 0x8f, 0x8f, 0x8f, 0x8f, 0x87, 0x87,
+  0x81, 0x80, 0x80, 0xff, 0x00, 0x1c, 0x10, 0x38, 0xfe, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xfe, 0x7c,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x1f, 0x0d, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xff, 0x00, 0x14, 0x11, 0x3e, 0x7f, 0xff, 0xff, 0xff,
+  0xff, 0x7f, 0x3e, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x1f, 0x04, 0x80,
+  0x80, 0x80, 0x80, 0xff, 0x00, 0x0b, 0x12, 0x7c, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xfe, 0x38,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x0d, 0x04, 0x81, 0x81, 0x81, 0x81,
+  0xff, 0x00, 0x04, 0x10, 0xc0, 0xf0, 0xf0, 0xf8, 0xf8, 0xf8, 0xf8, 0xf0, 0xe0, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x01, 0x04, 0x0d, 0x81, 0x87, 0x87, 0x8f, 0x8f, 0x8f, 0x8f, 0x87, 0x83,
+  0x80, 0x80, 0x80, 0x80, 0xff, 0x00, 0x04, 0x09, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00,
+  0x00, 0x01, 0x02, 0x0b, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbe, 0x80, 0x80, 0xff,
+};
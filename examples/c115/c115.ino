@@ -48,7 +48,8 @@ void setup() {
   lcd.display();
   delay(15000);
   lcd.clearDisplay();
-  //lcd.drawBitmap(70, 0, cara,8, 8, ST7558_BLACK);
+  lcd.drawPageBitmap_P(52, 4, cara, 8, 8);         // page format, any y
+  lcd.drawPageBitmap_P(50, 20, flecha, 16, 8, ST7558_ROP_XOR);
   //lcd.drawBitmap(0, 0, black, 96, 65, ST7558_BLACK);
   lcd.drawBitmap(69, 0, logo16, 16, 16, ST7558_BLACK);
   //lcd.drawFastVLine(50, 0, ST7558_HEIGHT, ST7558_BLACK);
@@ -0,0 +1,42 @@
+/***************************************************
+
+  Chart: a trend of analog input A0, a sample every 100 ms, with the
+  latest reading above it. Each sample moves the chart a column and
+  draws one new column; the chart is redrawn whole only when its scale
+  has to change.
+
+****************************************************/
+
+#include <ST7558.h>
+#include <ST7558_Chart.h>
+#include <ST7558_Field.h>
+#include <Wire.h>
+
+#define CHART_W 96
+#define CHART_H 56
+
+ST7558 lcd = ST7558();
+int16_t samples[CHART_W];
+ST7558_Chart chart(lcd, samples, 0, 9, CHART_W, CHART_H);
+ST7558_Field reading(lcd, 66, 0, 5);
+
+void setup() {
+  lcd.init();
+  lcd.setContrast(65);
+  lcd.clearDisplay();
+  lcd.setTextColor(ST7558_BLACK, ST7558_WHITE);
+  lcd.setCursor(0, 0);
+  lcd.print("A0");
+
+  chart.setGrid(16, 8);
+  lcd.display();
+}
+
+void loop() {
+  int16_t v = analogRead(A0);
+
+  chart.add(v);
+  reading.setNumber(v);
+  lcd.flush();
+  delay(100);
+}
@@ -0,0 +1,38 @@
+/***************************************************
+
+  Console: a title row that stays put over a scrolling log of analog
+  readings. Each line scrolls the region up a page and flush() sends
+  only the cells that changed, so a reading costs a few dozen bytes of
+  bus time instead of a whole frame.
+
+****************************************************/
+
+#include <ST7558.h>
+#include <ST7558_Console.h>
+#include <Wire.h>
+
+ST7558 lcd = ST7558();
+ST7558_Console con(lcd);
+uint16_t n;
+
+void setup() {
+  lcd.init();
+  lcd.setContrast(65);
+  lcd.clearDisplay();
+  lcd.display();
+
+  con.clear();
+  con.setInverse(true);
+  con.print(F(" A0 log         "));
+  con.setInverse(false);
+  con.setScrollRegion(1, ST7558_CONSOLE_ROWS - 1);
+  con.flush();
+}
+
+void loop() {
+  con.print(++n);
+  con.print(F(": "));
+  con.println(analogRead(A0));
+  con.flush();
+  delay(250);
+}
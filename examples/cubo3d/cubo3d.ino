@@ -4,10 +4,9 @@
  * 
  * ***************************************************************************/
 
-#include <avr/pgmspace.h>
-#include <math.h>
-#include <Adafruit_GFX.h>
 #include <ST7558.h>
+#include <Core_GFX_3D.h>
+#include <ST7558_Field.h>
 #include <Wire.h>
 
 #define RST_PIN A0
@@ -15,28 +14,29 @@
 ST7558 lcd = ST7558(RST_PIN);
 
 int zOff = 150;
-int xOff = 0;
-int yOff = 0;
 int cSize = 48;
 int view_plane = 36;
-float angle = PI/60;
-
-float cube3d[8][3] = {
-  {xOff - cSize,yOff + cSize,zOff - cSize},
-  {xOff + cSize,yOff + cSize,zOff - cSize},
-  {xOff - cSize,yOff - cSize,zOff - cSize},
-  {xOff + cSize,yOff - cSize,zOff - cSize},
-  {xOff - cSize,yOff + cSize,zOff + cSize},
-  {xOff + cSize,yOff + cSize,zOff + cSize},
-  {xOff - cSize,yOff - cSize,zOff + cSize},
-  {xOff + cSize,yOff - cSize,zOff + cSize}
+uint8_t angle = 2;              // 1/128 of a turn, close to the old PI/60
+
+static const GFXvertex cube3d[8] PROGMEM = {
+  {-48, 48,-48}, { 48, 48,-48}, {-48,-48,-48}, { 48,-48,-48},
+  {-48, 48, 48}, { 48, 48, 48}, {-48,-48, 48}, { 48,-48, 48}
+};
+static const GFXedge cubeEdges[14] PROGMEM = {
+  {0,1}, {0,2}, {0,4}, {1,5}, {1,3}, {2,6}, {2,3},
+  {4,6}, {4,5}, {7,6}, {7,3}, {7,5}, {0,3}, {1,2}
 };
-unsigned char cube2d[8][2];
+GFXpoint cube2d[8];
+Core_GFX_Mesh cube(cube3d, 8, cubeEdges, 14, cube2d);
+uint8_t ax, ay, az;
 
 unsigned long counter=0;
-uint8_t fps=0, fps_prev;
+uint8_t fps=0;
 #define EnableFps 1
 
+// Redraws only the digits that change from one frame to the next
+ST7558_Field fpsField(lcd, 33, 0, 3);
+
 void setup() {
   // put your setup code here, to run once:
   //Serial.begin(9600);
@@ -49,10 +49,12 @@ void setup() {
   
   lcd.clearDisplay();
 
+  cube.setPosition(0, 0, zOff);
+  cube.setProjection(view_plane, lcd.width()/2, lcd.height()/2);
   if(EnableFps){
-    lcd.setCursor(44,1);
-    lcd.setTextColor(ST7558_BLACK);
-    lcd.print("fps");
+    lcd.setTextColor(ST7558_BLACK, ST7558_WHITE);
+    lcd.setCursor(33 + 3*6, 0);
+    lcd.print(" fps");
   }
   lcd.display();
 }
@@ -62,37 +64,37 @@ void loop() {
   switch(random(6)) {
     case 0:
       for (int i = 0; i < rsteps; i++) {
-        zrotate(angle);
+        az += angle;
         printcube();
       }
       break;
     case 1:
       for (int i = 0; i < rsteps; i++) {
-        zrotate(2*PI - angle);
+        az -= angle;
         printcube();
       }
       break;
     case 2:
       for (int i = 0; i < rsteps; i++) {
-        xrotate(angle);
+        ax += angle;
         printcube();
       }
       break;
     case 3:
       for (int i = 0; i < rsteps; i++) {
-        xrotate(2*PI - angle);
+        ax -= angle;
         printcube();
       }
       break;
     case 4:
       for (int i = 0; i < rsteps; i++) {
-        yrotate(angle);
+        ay += angle;
         printcube();
       }
       break;
     case 5:
       for (int i = 0; i < rsteps; i++) {
-        yrotate(2*PI - angle);
+        ay -= angle;
         printcube();
       }
       break;
@@ -103,95 +105,28 @@ void loop() {
 
 void printcube() {
   
-  draw_cube(ST7558_WHITE);
-  
-  //calculate 2d points
-  for(byte i = 0; i < 8; i++) {
-    cube2d[i][0] = (unsigned char)((cube3d[i][0] * view_plane / cube3d[i][2]) + (lcd.width()/2));
-    cube2d[i][1] = (unsigned char)((cube3d[i][1] * view_plane / cube3d[i][2]) + (lcd.height()/2));
-  }
-  //lcd.clearDisplay();
-  draw_cube(ST7558_BLACK);
+  // Take off the previous frame: its corners, then its bounding box
+  draw_corners(ST7558_WHITE);
+  cube.erase(lcd, ST7558_WHITE);
+
+  // Rotated from the original vertices every frame, nothing accumulates
+  cube.setAngles(ax, ay, az);
+  cube.draw(lcd, ST7558_BLACK);
+  draw_corners(ST7558_BLACK);
 
   if(EnableFps){
-    lcd.setCursor(33,1);
-    lcd.setTextColor(ST7558_WHITE);
-    lcd.print(fps);
-  
-    fps = 1000/(millis()-counter);
-    lcd.setCursor(33,1);
-    lcd.setTextColor(ST7558_BLACK);
-    lcd.print(fps);
+    fpsField.setNumber(fps);
+
+    if (millis() != counter)
+      fps = 1000/(millis()-counter);
     counter = millis();
   }
   
   lcd.display();
 }
 
-void zrotate(float q) {
-  float tx,ty,temp;
-  for(byte i = 0; i < 8; i++) {
-    tx = cube3d[i][0] - xOff;
-    ty = cube3d[i][1] - yOff;
-    temp = tx * cos(q) - ty * sin(q);
-    ty = tx * sin(q) + ty * cos(q);
-    tx = temp;
-    cube3d[i][0] = tx + xOff;
-    cube3d[i][1] = ty + yOff;
-  }
-}
-
-void yrotate(float q) {
-  float tx,tz,temp;
-  for(byte i = 0; i < 8; i++) {
-    tx = cube3d[i][0] - xOff;
-    tz = cube3d[i][2] - zOff;
-    temp = tz * cos(q) - tx * sin(q);
-    tx = tz * sin(q) + tx * cos(q);
-    tz = temp;
-    cube3d[i][0] = tx + xOff;
-    cube3d[i][2] = tz + zOff;
-  }
-}
-
-void xrotate(float q) {
-  float ty,tz,temp;
-  for(byte i = 0; i < 8; i++) {
-    ty = cube3d[i][1] - yOff;
-    tz = cube3d[i][2] - zOff;
-    temp = ty * cos(q) - tz * sin(q);
-    tz = ty * sin(q) + tz * cos(q);
-    ty = temp;
-    cube3d[i][1] = ty + yOff;
-    cube3d[i][2] = tz + zOff;
-  }
-}
-
-void draw_cube(int16_t color) {
-  lcd.drawLine(cube2d[0][0],cube2d[0][1],cube2d[1][0],cube2d[1][1],color);
-  lcd.drawLine(cube2d[0][0],cube2d[0][1],cube2d[2][0],cube2d[2][1],color);
-  lcd.drawLine(cube2d[0][0],cube2d[0][1],cube2d[4][0],cube2d[4][1],color);
-  lcd.drawLine(cube2d[1][0],cube2d[1][1],cube2d[5][0],cube2d[5][1],color);
-  lcd.drawLine(cube2d[1][0],cube2d[1][1],cube2d[3][0],cube2d[3][1],color);
-  lcd.drawLine(cube2d[2][0],cube2d[2][1],cube2d[6][0],cube2d[6][1],color);
-  lcd.drawLine(cube2d[2][0],cube2d[2][1],cube2d[3][0],cube2d[3][1],color);
-  lcd.drawLine(cube2d[4][0],cube2d[4][1],cube2d[6][0],cube2d[6][1],color);
-  lcd.drawLine(cube2d[4][0],cube2d[4][1],cube2d[5][0],cube2d[5][1],color);
-  lcd.drawLine(cube2d[7][0],cube2d[7][1],cube2d[6][0],cube2d[6][1],color);
-  lcd.drawLine(cube2d[7][0],cube2d[7][1],cube2d[3][0],cube2d[3][1],color);
-  lcd.drawLine(cube2d[7][0],cube2d[7][1],cube2d[5][0],cube2d[5][1],color);
-  
-  lcd.drawLine(cube2d[0][0], cube2d[0][1], cube2d[3][0], cube2d[3][1], color);
-  lcd.drawLine(cube2d[1][0], cube2d[1][1], cube2d[2][0], cube2d[2][1], color);
-  
+void draw_corners(int16_t color) {
   uint8_t radio=1;
-  lcd.fillCircle(cube2d[0][0],cube2d[0][1],radio,color);
-  lcd.fillCircle(cube2d[1][0],cube2d[1][1],radio,color);
-  lcd.fillCircle(cube2d[2][0],cube2d[2][1],radio,color);
-  lcd.fillCircle(cube2d[3][0],cube2d[3][1],radio,color);
-  lcd.fillCircle(cube2d[4][0],cube2d[4][1],radio,color);
-  lcd.fillCircle(cube2d[5][0],cube2d[5][1],radio,color);
-  lcd.fillCircle(cube2d[6][0],cube2d[6][1],radio,color);
-  lcd.fillCircle(cube2d[7][0],cube2d[7][1],radio,color);
+  for (uint8_t i = 0; i < 8; i++)
+    lcd.fillCircle(cube2d[i].x, cube2d[i].y, radio, color);
 }
-
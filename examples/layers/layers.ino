@@ -0,0 +1,55 @@
+/***************************************************
+
+  Layers: a grid and labels drawn once into the framebuffer, a moving
+  trace drawn into an overlay. Each frame clears and redraws only the
+  overlay, and flush() sends only the columns that changed, with the
+  grid combined back in as the bytes go out.
+
+****************************************************/
+
+#include <ST7558.h>
+#include <Wire.h>
+
+ST7558 lcd = ST7558();
+uint8_t overlay[ST7558_PAGES][ST7558_RAM_WIDTH];
+uint8_t trace;
+int16_t x, lastY;
+
+void setup() {
+  int16_t i;
+
+  lcd.init();
+  lcd.setContrast(65);
+  lcd.clearDisplay();
+
+  // Background, layer 0
+  for (i = 0; i < lcd.width(); i += 12)
+    lcd.drawFastVLine(i, 8, lcd.height() - 8, ST7558_BLACK);
+  for (i = 8; i < lcd.height(); i += 8)
+    lcd.drawFastHLine(0, i, lcd.width(), ST7558_BLACK);
+  lcd.setTextColor(ST7558_BLACK);
+  lcd.setCursor(0, 0);
+  lcd.print(F("A0 input"));
+  lcd.display();
+
+  // The trace inverts the grid where it crosses it
+  trace = lcd.addLayer(overlay, ST7558_ROP_XOR);
+  lcd.setLayer(trace);
+  lastY = -1;
+}
+
+void loop() {
+  int16_t y = lcd.height() - 1 - (analogRead(A0) >> 4) * (lcd.height() - 9) / 64;
+
+  // Wipe a column ahead of the pen
+  lcd.fillRect(x, 8, 4, lcd.height() - 8, ST7558_WHITE);
+  if (lastY >= 0)
+    lcd.drawLine(x - 1, lastY, x, y, ST7558_BLACK);
+  lastY = y;
+  if (++x >= lcd.width()) {
+    x = 0;
+    lastY = -1;
+  }
+  lcd.flush();
+  delay(20);
+}
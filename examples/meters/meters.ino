@@ -0,0 +1,47 @@
+/***************************************************
+
+  Meters: a needle gauge and a level bar following analog input A0,
+  and a progress bar with its percentage counting up. Each update
+  draws only what moved, the grown or shrunk end of a bar or the old
+  and new needle, and flush() sends just those columns.
+
+****************************************************/
+
+#include <ST7558.h>
+#include <ST7558_Meter.h>
+#include <ST7558_Field.h>
+#include <Wire.h>
+
+ST7558 lcd = ST7558();
+// Three quarters of a turn, clockwise from bottom left
+ST7558_Gauge gauge(lcd, 32, 30, 20, GFX_ANGLE(225), -GFX_ANGLE(270));
+ST7558_Bar level(lcd, 80, 2, 12, 50, ST7558_METER_VERTICAL | ST7558_METER_FRAME);
+ST7558_Bar progress(lcd, 0, 56, 70, 9);
+ST7558_Field percent(lcd, 72, 57, 4);
+uint8_t done;
+
+void setup() {
+  lcd.init();
+  lcd.setContrast(65);
+  lcd.clearDisplay();
+
+  gauge.setRange(0, 1023);
+  gauge.setTicks(10);
+  gauge.draw();
+  level.setRange(0, 1023);
+  level.draw();
+  progress.draw();
+  lcd.display();
+}
+
+void loop() {
+  int16_t v = analogRead(A0);
+
+  gauge.setValue(v);
+  level.setValue(v);
+  if (++done > 100) done = 0;
+  progress.setValue(done);
+  percent.setNumber(done);
+  lcd.flush();
+  delay(50);
+}
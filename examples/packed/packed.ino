@@ -0,0 +1,64 @@
+/***************************************************
+
+  Packed bitmaps: a full screen image stored run length coded and
+  decoded while it is drawn. Prints the decode cost next to the flush
+  time on the serial port.
+
+  splash.h is made from splash.pbm with
+      tools/packbitmap.py splash.pbm -o splash.h
+
+****************************************************/
+
+#include <ST7558.h>
+#include <Wire.h>
+#include "splash.h"
+
+ST7558 lcd = ST7558();
+
+void setup() {
+  unsigned long t0, tDecode, tFlush, tDirect;
+  uint8_t i;
+
+  Serial.begin(9600);
+  lcd.init();
+  lcd.setContrast(65);
+
+  // Decode into the framebuffer, then send it
+  lcd.clearDisplay();
+  t0 = micros();
+  for (i = 0; i < 10; i++)
+    lcd.drawPackedBitmap(0, 0, splash);
+  tDecode = (micros() - t0) / 10;
+
+  t0 = micros();
+  lcd.display();
+  tFlush = micros() - t0;
+
+  // Decode straight onto the bus, no framebuffer
+  t0 = micros();
+  lcd.displayPacked(splash);
+  tDirect = micros() - t0;
+
+  Serial.print(F("splash: "));
+  Serial.print(sizeof(splash));
+  Serial.print(F(" bytes of flash for "));
+  Serial.print(pgm_read_byte(&splash[0]) *
+    ((pgm_read_byte(&splash[1]) + 7) / 8));
+  Serial.println(F(" bytes of pixels"));
+  Serial.print(F("drawPackedBitmap: "));
+  Serial.print(tDecode);
+  Serial.println(F(" us"));
+  Serial.print(F("display:          "));
+  Serial.print(tFlush);
+  Serial.println(F(" us"));
+  Serial.print(F("displayPacked:    "));
+  Serial.print(tDirect);
+  Serial.println(F(" us"));
+
+  // Unaligned and combined: XOR it over itself shifted by 3 rows
+  lcd.drawPackedBitmap(0, 3, splash, ST7558_ROP_XOR);
+  lcd.display();
+}
+
+void loop() {
+}
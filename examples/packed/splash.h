@@ -0,0 +1,28 @@
+// Generated by tools/packbitmap.py, do not edit.
+
+#ifdef __AVR__
+ #include <avr/pgmspace.h>
+#elif defined(ESP8266)
+ #include <pgmspace.h>
+#else
+ #define PROGMEM
+#endif
+
+// splash.pbm: 96x64, 232 bytes packed from 768
+const uint8_t splash[] PROGMEM = {
+  0x60, 0x40, 0x00, 0xff, 0xa1, 0x01, 0x80, 0x81, 0x81, 0xc1, 0x8d, 0xe1, 0x81, 0xc1, 0x80, 0x81,
+  0xa0, 0x01, 0x80, 0xff, 0x97, 0x00, 0x0c, 0x80, 0xc0, 0xe0, 0xf0, 0xf8, 0xfc, 0xfc, 0xfe, 0xff,
+  0x7f, 0x3f, 0x1f, 0x1f, 0x81, 0x0f, 0x84, 0x07, 0x00, 0x03, 0x84, 0x07, 0x81, 0x0f, 0x80, 0x1f,
+  0x0a, 0x3f, 0x7f, 0xff, 0xfe, 0xfc, 0xfc, 0xf8, 0xf0, 0xe0, 0xc0, 0x80, 0x96, 0x00, 0x80, 0xff,
+  0x93, 0x00, 0x0a, 0xc0, 0xf0, 0xfc, 0xfe, 0xff, 0xff, 0x7f, 0x1f, 0x0f, 0x07, 0x01, 0x9d, 0x00,
+  0x0a, 0x01, 0x07, 0x0f, 0x1f, 0x7f, 0xff, 0xff, 0xfe, 0xfc, 0xf0, 0xc0, 0x92, 0x00, 0x80, 0xff,
+  0x92, 0x00, 0x00, 0xfe, 0x83, 0xff, 0x00, 0x03, 0xa7, 0x00, 0x00, 0x03, 0x83, 0xff, 0x00, 0xfe,
+  0x91, 0x00, 0x80, 0xff, 0x88, 0x00, 0x88, 0xc0, 0x83, 0xff, 0x00, 0xfe, 0xa9, 0xc0, 0x00, 0xfe,
+  0x83, 0xff, 0x88, 0xc0, 0x87, 0x00, 0x80, 0xff, 0x88, 0x00, 0x89, 0x03, 0x02, 0x07, 0x1f, 0x7f,
+  0x82, 0xff, 0x02, 0xf3, 0xe3, 0xc3, 0x9f, 0x03, 0x02, 0xc3, 0xe3, 0xf3, 0x82, 0xff, 0x02, 0x7f,
+  0x1f, 0x07, 0x89, 0x03, 0x87, 0x00, 0x80, 0xff, 0x97, 0x00, 0x0c, 0x03, 0x07, 0x0f, 0x1f, 0x3f,
+  0x7f, 0x7f, 0xfe, 0xfe, 0xfc, 0xf8, 0xf0, 0xf0, 0x81, 0xe0, 0x84, 0xc0, 0x00, 0x80, 0x84, 0xc0,
+  0x81, 0xe0, 0x80, 0xf0, 0x0a, 0xf8, 0xfc, 0xfe, 0xfe, 0x7f, 0x7f, 0x3f, 0x1f, 0x0f, 0x07, 0x03,
+  0x96, 0x00, 0x80, 0xff, 0x9f, 0x80, 0x80, 0x81, 0x80, 0x83, 0x81, 0x87, 0x8d, 0x8f, 0x81, 0x87,
+  0x80, 0x83, 0x80, 0x81, 0x9e, 0x80, 0x00, 0xff,
+};
@@ -0,0 +1,81 @@
+/***************************************************
+
+  Sprites: a masked ball bouncing over a grey background, and an XOR
+  crosshair circling through it. update() takes off and puts back only
+  the sprites that moved, so flush() sends just the columns around
+  them. Each time the two meet, the sprites come off, the hit counter
+  in the corner is redrawn, and update() puts them back on top.
+
+****************************************************/
+
+#include <ST7558.h>
+#include <ST7558_Sprite.h>
+#include <Core_GFX_3D.h>
+#include <Wire.h>
+
+// 8x8 page-format images, one byte per column, LSB on top
+const uint8_t ball[] PROGMEM = {
+  0x3C, 0x42, 0x99, 0x85, 0x81, 0x81, 0x42, 0x3C
+};
+const uint8_t ballMask[] PROGMEM = {
+  0x3C, 0x7E, 0xFF, 0xFF, 0xFF, 0xFF, 0x7E, 0x3C
+};
+const uint8_t crosshair[] PROGMEM = {
+  0x08, 0x08, 0x08, 0x77, 0x08, 0x08, 0x08
+};
+
+ST7558 lcd = ST7558();
+ST7558_Sprites sprites(lcd);
+ST7558_Sprite puck(ball, ballMask, 8, 8);   // save-under from the pool
+ST7558_Sprite cursor(crosshair, 7, 7);       // XOR
+int16_t x = 10, y = 20, dx = 1, dy = 1;
+uint8_t angle;
+uint16_t hits;
+boolean touching;
+
+void setup() {
+  lcd.init();
+  lcd.setContrast(65);
+  lcd.clearDisplay();
+
+  lcd.fillRectPattern(0, 8, lcd.width(), lcd.height() - 8,
+    st7558_patternLight, ST7558_BLACK, ST7558_WHITE);
+  lcd.setTextColor(ST7558_BLACK, ST7558_WHITE);
+  showHits();
+  lcd.display();
+
+  sprites.add(puck);
+  sprites.add(cursor);
+}
+
+void loop() {
+  boolean hit;
+
+  x += dx;
+  y += dy;
+  if ((x <= 0) || (x >= lcd.width() - 8)) dx = -dx;
+  if ((y <= 8) || (y >= lcd.height() - 8)) dy = -dy;
+  puck.moveTo(x, y);
+  angle += 2;
+  cursor.moveTo(lcd.width() / 2 - 3 + ((24 * gfxCos(angle)) >> 15),
+    (lcd.height() + 8) / 2 - 3 - ((20 * gfxSin(angle)) >> 15));
+
+  // Count a meeting once, not every frame of it
+  hit = puck.collides(cursor);
+  if (hit && !touching) {
+    hits++;
+    sprites.erase();
+    showHits();
+  }
+  touching = hit;
+
+  sprites.update();
+  lcd.flush();
+  delay(30);
+}
+
+void showHits(void) {
+  lcd.setCursor(0, 0);
+  lcd.print(F("Hits "));
+  lcd.print(hits);
+}
@@ -0,0 +1,61 @@
+/***************************************************
+
+  Tilemap: a 32 x 8 tile level scrolled sideways a pixel per frame,
+  with a coin blinking in and out. Each frame moves the window's
+  contents, draws the one column of pixels that comes into view and
+  the tiles that changed, and flush() sends just that.
+
+****************************************************/
+
+#include <ST7558.h>
+#include <ST7558_Tilemap.h>
+#include <Wire.h>
+
+#define SKY    0
+#define GROUND 1
+#define BRICK  2
+#define COIN   3
+
+// 8x8 tiles, one byte per column, LSB on top
+const uint8_t tiles[] PROGMEM = {
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,   // sky
+  0xFF, 0x55, 0xFF, 0xAA, 0xFF, 0x55, 0xFF, 0xAA,   // ground
+  0xFF, 0x81, 0x81, 0xFF, 0xFF, 0x81, 0x81, 0xFF,   // brick
+  0x00, 0x3C, 0x42, 0x5A, 0x5A, 0x42, 0x3C, 0x00    // coin
+};
+
+#define MAP_W 32
+#define MAP_H 8
+
+ST7558 lcd = ST7558();
+uint8_t level[MAP_W * MAP_H];
+ST7558_Tilemap world(lcd, tiles, level, MAP_W, MAP_H, 0, 0, 96, 64);
+int16_t scroll;
+uint8_t frame;
+
+void setup() {
+  uint8_t col;
+
+  lcd.init();
+  lcd.setContrast(65);
+  lcd.clearDisplay();
+
+  for (col = 0; col < MAP_W; col++) {
+    level[7 * MAP_W + col] = GROUND;
+    if ((col % 6) == 3) level[4 * MAP_W + col] = BRICK;
+  }
+  world.draw();
+  lcd.flush();
+}
+
+void loop() {
+  if (++frame == 20) {
+    frame = 0;
+    world.setTile(9, 3, world.getTile(9, 3) == COIN ? SKY : COIN);
+  }
+  if (++scroll > (MAP_W - 12) * 8) scroll = 0;
+  world.scrollTo(scroll, 0);
+  world.draw();
+  lcd.flush();
+  delay(30);
+}
@@ -32,18 +32,34 @@ POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "Core_GFX.h"
-#include "glcdfont.h"
+#include "Core_GFX_T.h"
+
+// Build with the glyph subset written by tools/fontsubset.py instead of the
+// full 224 glyph font5x8 (1120 bytes of flash) by defining enableFontSubset
+// in the build flags, e.g. build_flags = -DenableFontSubset on PlatformIO or
+// --build-property compiler.cpp.extra_flags=-DenableFontSubset with
+// arduino-cli. The library source itself needs no edit.
+
+#ifdef enableFontSubset
+ #include "glcdfont_subset.h"
+#else
+ #include "glcdfont.h"
+#endif
 #ifdef __AVR__
  #include <avr/pgmspace.h>
 #elif defined(ESP8266)
  //#include <pgmspace.h>
 #else
  #define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+ #define pgm_read_word(addr) (*(const unsigned short *)(addr))
 #endif
 
 #ifndef min
  #define min(a,b) ((a < b) ? a : b)
 #endif
+#ifndef max
+ #define max(a,b) ((a > b) ? a : b)
+#endif
 
 Core_GFX::Core_GFX(int16_t w, int16_t h):
   WIDTH(w), HEIGHT(h)
@@ -55,78 +71,25 @@ Core_GFX::Core_GFX(int16_t w, int16_t h):
   textsize  = 1;
   textcolor = textbgcolor = 0xFFFF;
   wrap      = true;
-  
+  font      = &font5x8Font;
+  origin_x  = origin_y = 0;
+  viewports = 0;
+  clip_x0   = clip_y0 = 0;
+  clip_x1   = _width - 1;
+  clip_y1   = _height - 1;
 }
 
 // Draw a circle outline
 void Core_GFX::drawCircle(int16_t x0, int16_t y0, int16_t column,
     uint16_t color) {
-  int16_t f = 1 - column;
-  int16_t ddF_x = 1;
-  int16_t ddF_y = -2 * column;
-  int16_t x = 0;
-  int16_t y = column;
-
-  drawPixel(x0  , y0+column, color);
-  drawPixel(x0  , y0-column, color);
-  drawPixel(x0+column, y0  , color);
-  drawPixel(x0-column, y0  , color);
-
-  while (x<y) {
-    if (f >= 0) {
-      y--;
-      ddF_y += 2;
-      f += ddF_y;
-    }
-    x++;
-    ddF_x += 2;
-    f += ddF_x;
-  
-    drawPixel(x0 + x, y0 + y, color);
-    drawPixel(x0 - x, y0 + y, color);
-    drawPixel(x0 + x, y0 - y, color);
-    drawPixel(x0 - x, y0 - y, color);
-    drawPixel(x0 + y, y0 + x, color);
-    drawPixel(x0 - y, y0 + x, color);
-    drawPixel(x0 + y, y0 - x, color);
-    drawPixel(x0 - y, y0 - x, color);
-  }
+  if (outsideClip(x0 - column, y0 - column, 2*column + 1, 2*column + 1))
+    return;
+  plotCircle(*this, x0, y0, column, 0x10 | 0xF, color);
 }
 
 void Core_GFX::drawCircleHelper( int16_t x0, int16_t y0,
                int16_t column, uint8_t cornername, uint16_t color) {
-  int16_t f     = 1 - column;
-  int16_t ddF_x = 1;
-  int16_t ddF_y = -2 * column;
-  int16_t x     = 0;
-  int16_t y     = column;
-
-  while (x<y) {
-    if (f >= 0) {
-      y--;
-      ddF_y += 2;
-      f     += ddF_y;
-    }
-    x++;
-    ddF_x += 2;
-    f     += ddF_x;
-    if (cornername & 0x4) {
-      drawPixel(x0 + x, y0 + y, color);
-      drawPixel(x0 + y, y0 + x, color);
-    } 
-    if (cornername & 0x2) {
-      drawPixel(x0 + x, y0 - y, color);
-      drawPixel(x0 + y, y0 - x, color);
-    }
-    if (cornername & 0x8) {
-      drawPixel(x0 - y, y0 + x, color);
-      drawPixel(x0 - x, y0 + y, color);
-    }
-    if (cornername & 0x1) {
-      drawPixel(x0 - y, y0 - x, color);
-      drawPixel(x0 - x, y0 - y, color);
-    }
-  }
+  plotCircle(*this, x0, y0, column, cornername, color);
 }
 
 void Core_GFX::fillCircle(int16_t x0, int16_t y0, int16_t column,
@@ -238,8 +201,10 @@ void Core_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
   }
 }
 
+// Fills what the clip rectangle leaves drawable, i.e. the whole viewport
 void Core_GFX::fillScreen(uint16_t color) {
-  fillRect(0, 0, _width, _height, color);
+  fillRect(clip_x0 - origin_x, clip_y0 - origin_y,
+    clip_x1 - clip_x0 + 1, clip_y1 - clip_y0 + 1, color);
 }
 
 // Draw a rounded rectangle
@@ -356,19 +321,51 @@ void Core_GFX::fillTriangle ( int16_t x0, int16_t y0,
   }
 }
 
+// Scatter of single pixels, e.g. plots and particles
+void Core_GFX::drawPixels(const GFXpoint *pts, uint16_t n, uint16_t color) {
+  startWrite();
+  while (n--) {
+    drawPixel(pts->x, pts->y, color);
+    pts++;
+  }
+  endWrite();
+}
+
+void Core_GFX::startWrite(void) {
+}
+
+void Core_GFX::endWrite(void) {
+}
+
+// Draw a closed polygon outline
+void Core_GFX::drawPolygon(const GFXpoint *pts, uint8_t n, uint16_t color) {
+  uint8_t i;
+
+  if (!n) return;
+  for (i = 1; i < n; i++)
+    drawLine(pts[i-1].x, pts[i-1].y, pts[i].x, pts[i].y, color);
+  drawLine(pts[n-1].x, pts[n-1].y, pts[0].x, pts[0].y, color);
+}
+
+// Fill a polygon, convex or not (even-odd rule). The outline is part of the
+// shape: spans alone miss the edges that run along the scan direction.
+void Core_GFX::fillPolygon(const GFXpoint *pts, uint8_t n, uint16_t color) {
+  Core_GFX_PolygonScan scan(pts, n, false,
+    clip_y0 - origin_y, clip_y1 - origin_y);
+  int16_t y, a, b;
+
+  while (scan.nextLine(y))
+    while (scan.nextSpan(a, b))
+      drawFastHLine(a, y, b - a + 1, color);
+  if (n <= GFX_POLYGON_MAX)
+    drawPolygon(pts, n, color);
+}
+
 void Core_GFX::drawBitmap(int16_t x, int16_t y,
 			      const uint8_t *bitmap, int16_t w, int16_t h,
 			      uint16_t color) {
-
-  int16_t i, j, byteWidth = (w + 7) / 8;
-
-  for(j=0; j<h; j++) {
-    for(i=0; i<w; i++ ) {
-      if(pgm_read_byte(bitmap + j * byteWidth + i / 8) & (128 >> (i & 7))) {
-        drawPixel(x+i, y+j, color);
-      }
-    }
-  }
+  if (outsideClip(x, y, w, h)) return;
+  plotBitmap(*this, x, y, bitmap, w, h, color, color, false);
 }
 
 // Draw a 1-bit color bitmap at the specified x, y position from the
@@ -377,19 +374,8 @@ void Core_GFX::drawBitmap(int16_t x, int16_t y,
 void Core_GFX::drawBitmap(int16_t x, int16_t y,
             const uint8_t *bitmap, int16_t w, int16_t h,
             uint16_t color, uint16_t bg) {
-
-  int16_t i, j, byteWidth = (w + 7) / 8;
-  
-  for(j=0; j<h; j++) {
-    for(i=0; i<w; i++ ) {
-      if(pgm_read_byte(bitmap + j * byteWidth + i / 8) & (128 >> (i & 7))) {
-        drawPixel(x+i, y+j, color);
-      }
-      else {
-      	drawPixel(x+i, y+j, bg);
-      }
-    }
-  }
+  if (outsideClip(x, y, w, h)) return;
+  plotBitmap(*this, x, y, bitmap, w, h, color, bg, false);
 }
 
 //Draw XBitMap Files (*.xbm), exported from GIMP,
@@ -398,16 +384,8 @@ void Core_GFX::drawBitmap(int16_t x, int16_t y,
 void Core_GFX::drawXBitmap(int16_t x, int16_t y,
                               const uint8_t *bitmap, int16_t w, int16_t h,
                               uint16_t color) {
-  
-  int16_t i, j, byteWidth = (w + 7) / 8;
-  
-  for(j=0; j<h; j++) {
-    for(i=0; i<w; i++ ) {
-      if(pgm_read_byte(bitmap + j * byteWidth + i / 8) & (1 << (i % 8))) {
-        drawPixel(x+i, y+j, color);
-      }
-    }
-  }
+  if (outsideClip(x, y, w, h)) return;
+  plotBitmap(*this, x, y, bitmap, w, h, color, color, true);
 }
 
 #if ARDUINO >= 100
@@ -415,85 +393,18 @@ size_t Core_GFX::write(uint8_t c) {
 #else
 void Core_GFX::write(uint8_t c) {
 #endif
-	if (c == '\n') {
+  uint16_t cp, glyph;
+
+  if (!decodeUTF8(c, utf8state, utf8codepoint, cp)) {
+    // Code point still incomplete
+  } else if (cp == '\n') {
     cursor_y += textsize*8;
     cursor_x  = 0;
-  } else if (c == '\c') {
-    // skip em
-  }
-  else if (c == 0x0D)
-  {
-	  cursor_x = 0;
-  }
-  else {
-	  
-	  ///
-	  
-	  if (((c == 0xD0 )||(c == 0xD1)) & (utf8handle==0x00) ) {
-	  utf8handle = c;
-
-#if ARDUINO >= 100
-			return 1;
-#endif
-
-		exit;
-	  
-	  };
-	  
-	  if ( utf8handle != 0x00) {
-		  
-		   switch (utf8handle)
-			  {
-			  case 0xD0:
-				  switch (c)
-				  {
-				  case 0x81:
-					  //Ё 
-					  c = 143;
-					  break;
-				  case 0x86:
-					 // І Ukrain
-					  c = 178;
-					  break;
-
-				  case 0x87:
-					  //Ї Ukrain
-					  c = 175;
-					  break;
-				  default:
-					  c += 48;
-					  break;
-				  }
-				  break;
-			  case 0xD1:
-				  switch (c)
-				  {
-				  case 0x91:
-					  //ё
-					  c = 184;
-					  break;
-				  case 0x96:
-						//і Ukrain
-					  c = 179;
-						  break;
-
-				  case 0x97:
-					  //ї
-					  c = 191;
-					  break;
-				  
-				  default:
-					  c += 112;
-					  break;
-				  }
-				  			  
-				  break;
-
-			  }
-		   utf8handle = 0x00;
-				}
-
-    drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize);
+  } else if (cp == '\r') {
+    cursor_x  = 0;
+  } else if ((glyph = glyphIndex(cp)) != GFX_NO_GLYPH) {
+    // Code points the font doesn't carry are skipped
+    drawGlyph(cursor_x, cursor_y, glyph, textcolor, textbgcolor, textsize);
    // в зависимости от ориентации текста в какую сторону будем писать следующий символ
 	switch (textdirection)
 	{
@@ -521,45 +432,78 @@ void Core_GFX::write(uint8_t c) {
 #endif
 }
 
+// Streaming UTF-8 decoder: lead bytes start a code point, continuation bytes
+// complete it. Returns true once 'cp' holds a complete code point.
+boolean Core_GFX::decodeUTF8(uint8_t c, uint8_t &pending,
+  uint16_t &codepoint, uint16_t &cp) {
 
-
+  if (c < 0x80) {
+    pending = 0;
+    cp = c;
+    return true;
+  }
+  if (c < 0xC0) {
+    if (!pending) return false;           // stray continuation byte
+    if (codepoint != GFX_NO_GLYPH)
+      codepoint = (codepoint << 6) | (c & 0x3F);
+    if (--pending) return false;
+    cp = codepoint;
+    return true;
+  }
+  if (c < 0xE0) {
+    codepoint = c & 0x1F;
+    pending = 1;
+  } else if (c < 0xF0) {
+    codepoint = c & 0x0F;
+    pending = 2;
+  } else {
+    codepoint = GFX_NO_GLYPH;             // beyond the BMP, never mapped
+    pending = 3;
+  }
+  return false;
+}
+
+// The first run is tried before the binary search of the rest. In the full
+// font that is all of printable ASCII, so plain text needs no search; a
+// subset's first run is just its lowest code points.
+uint16_t Core_GFX::glyphIndex(uint16_t cp) const {
+  const GFXrange *r = font->range;
+  uint16_t first = pgm_read_word(&r->first);
+  uint8_t lo, hi, mid;
+
+  if ((cp >= first) && (cp <= pgm_read_word(&r->last)))
+    return pgm_read_word(&r->glyph) + (cp - first);
+
+  lo = 1;
+  hi = font->rangeCount;
+  while (lo < hi) {
+    mid = (lo + hi) >> 1;
+    r = font->range + mid;
+    first = pgm_read_word(&r->first);
+    if (cp < first)
+      hi = mid;
+    else if (cp > pgm_read_word(&r->last))
+      lo = mid + 1;
+    else
+      return pgm_read_word(&r->glyph) + (cp - first);
+  }
+  return GFX_NO_GLYPH;
+}
 
 // Draw a character
 void Core_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
-	uint8_t row,column,FontHeight,FontWidth;
-	uint8_t X,Y,F,Z;
-	uint8_t tmp;
-	
-	c-=32;
-	// x ширина x+5 точек символ
-	FontHeight=8 * textsize;
-	FontWidth=5 * textsize;
-	for (column=0; column<FontWidth;column++ )
-	{
-		 
-		Z=column/ textsize;
-		tmp= pgm_read_byte(&font5x8[c][Z]);
-		
-		for (row= 0;row<FontHeight;row++)
-		{
-			F = (row / size);
-			X = x + column;
-			Y = y + row;
-			if ((tmp & (1 << F)) != 0) {
-				drawPixel(X, Y, color);
-			}
-			else if (bg != color)
-			{
-				drawPixel(X, Y, bg);
-			};
-		}
-	} 
+	uint16_t glyph = glyphIndex(c);
 
-  }
+	if (glyph != GFX_NO_GLYPH)
+		drawGlyph(x, y, glyph, color, bg, size);
+}
+
+// Draw a glyph of the current font by index
+void Core_GFX::drawGlyph(int16_t x, int16_t y, uint16_t glyph, uint16_t color, uint16_t bg, uint8_t size) {
+  if (outsideClip(x, y, GFX_GLYPH_WIDTH * size, 8 * size)) return;
+  plotGlyph(*this, x, y, glyph, color, bg, size);
+}
 
-  
-  
-  
 void Core_GFX::setCursor(int16_t x, int16_t y) {
   cursor_x = x;
   cursor_y = y;
@@ -610,6 +554,9 @@ void Core_GFX::setRotation(uint8_t x) {
 	   _height = WIDTH;
     break;
   }
+  viewports = 0;
+  origin_x  = origin_y = 0;
+  resetClipRect();
 }
 
 void  Core_GFX::setTextDirection(uint8_t d){
@@ -618,6 +565,91 @@ void  Core_GFX::setTextDirection(uint8_t d){
 
 }
 
+// Viewport: primitives take coordinates relative to the origin and draw
+// only inside the clip rectangle. The clip rectangle is given relative to
+// the current origin and kept in screen coordinates.
+void Core_GFX::setOrigin(int16_t x, int16_t y) {
+  origin_x = x;
+  origin_y = y;
+}
+
+void Core_GFX::setClipRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+  clip_x0 = max(x + origin_x, 0);
+  clip_y0 = max(y + origin_y, 0);
+  clip_x1 = min(x + origin_x + w - 1, _width - 1);
+  clip_y1 = min(y + origin_y + h - 1, _height - 1);
+  clipChanged();
+}
+
+// The clip rectangle relative to the origin, w or h 0 when it is empty
+void Core_GFX::getClipRect(int16_t &x, int16_t &y, int16_t &w, int16_t &h) const {
+  x = clip_x0 - origin_x;
+  y = clip_y0 - origin_y;
+  w = max(clip_x1 - clip_x0 + 1, 0);
+  h = max(clip_y1 - clip_y0 + 1, 0);
+}
+
+void Core_GFX::resetClipRect(void) {
+  clip_x0 = clip_y0 = 0;
+  clip_x1 = _width - 1;
+  clip_y1 = _height - 1;
+  clipChanged();
+}
+
+// Save the viewport, then move the origin to x, y and narrow the clip to
+// the w x h box there, so a widget can draw in its own coordinates
+void Core_GFX::pushViewport(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (viewports < GFX_VIEWPORT_DEPTH) {
+    viewport[viewports].ox = origin_x;
+    viewport[viewports].oy = origin_y;
+    viewport[viewports].x0 = clip_x0;
+    viewport[viewports].y0 = clip_y0;
+    viewport[viewports].x1 = clip_x1;
+    viewport[viewports].y1 = clip_y1;
+  }
+  viewports++;
+
+  origin_x += x;
+  origin_y += y;
+  clip_x0 = max(clip_x0, origin_x);
+  clip_y0 = max(clip_y0, origin_y);
+  clip_x1 = min(clip_x1, origin_x + w - 1);
+  clip_y1 = min(clip_y1, origin_y + h - 1);
+  clipChanged();
+}
+
+void Core_GFX::popViewport(void) {
+  if (!viewports) return;
+  if (--viewports < GFX_VIEWPORT_DEPTH) {
+    origin_x = viewport[viewports].ox;
+    origin_y = viewport[viewports].oy;
+    clip_x0  = viewport[viewports].x0;
+    clip_y0  = viewport[viewports].y0;
+    clip_x1  = viewport[viewports].x1;
+    clip_y1  = viewport[viewports].y1;
+    clipChanged();
+  }
+}
+
+// True when a w x h box at x, y (relative to the origin) can't touch the
+// clip rectangle, so a primitive can skip it as a whole
+boolean Core_GFX::outsideClip(int16_t x, int16_t y, int16_t w, int16_t h) const {
+  x += origin_x;
+  y += origin_y;
+  return (x > clip_x1) || (y > clip_y1) ||
+    (x + w <= clip_x0) || (y + h <= clip_y0);
+}
+
+void Core_GFX::clipChanged(void) {
+  // Nothing to do, may be subclassed
+}
+
+// NULL selects the built-in font5x8
+void Core_GFX::setFont(const GFXfont *f) {
+  font = f ? f : &font5x8Font;
+  utf8state = 0;
+}
+
 
 // Return the size of the display (per current rotation)
 int16_t Core_GFX::width(void) const{
@@ -632,6 +664,101 @@ void Core_GFX::invertDisplay(boolean i) {
   // Do nothing, must be subclassed if supported
 }
 
+/***************************************************************************/
+// scanline polygon rasteriser
+
+// Lines run from 'first' to 'last' at most, lines outside are skipped
+// without being walked. An edge covers [start, end): the line it ends on
+// belongs to the next edge, except on the polygon's last line.
+Core_GFX_PolygonScan::Core_GFX_PolygonScan(const GFXpoint *pts, uint8_t n,
+  boolean columns, int16_t first, int16_t last)
+{
+  int16_t s0, t0, s1, t1, smin, smax;
+  uint8_t i, j;
+
+  edges = pending = actives = span = 0;
+  line = 0;
+  this->last = -1;
+  if ((n < 3) || (n > GFX_POLYGON_MAX)) return;
+
+  smin = smax = columns ? pts[0].x : pts[0].y;
+  for (i = 1; i < n; i++) {
+    s0 = columns ? pts[i].x : pts[i].y;
+    if (s0 < smin) smin = s0;
+    if (s0 > smax) smax = s0;
+  }
+
+  for (i = 0; i < n; i++) {
+    j = (i + 1 < n) ? i + 1 : 0;
+    if (columns) {
+      s0 = pts[i].x; t0 = pts[i].y; s1 = pts[j].x; t1 = pts[j].y;
+    } else {
+      s0 = pts[i].y; t0 = pts[i].x; s1 = pts[j].y; t1 = pts[j].x;
+    }
+    if (s0 == s1) continue;       // parallel to the scan, spans cover it
+    if (s0 > s1) {
+      swap(s0, s1);
+      swap(t0, t1);
+    }
+
+    // Edge table, insertion sorted by first line
+    for (j = edges; (j > 0) && (edge[j-1].start > s0); j--)
+      edge[j] = edge[j-1];
+    edge[j].start = s0;
+    edge[j].end   = (s1 == smax) ? s1 + 1 : s1;
+    edge[j].t     = t0 * 65536L + 0x8000;       // +0.5 rounds the crossing
+    edge[j].dt    = (t1 - t0) * 65536L / (s1 - s0);
+    edges++;
+  }
+
+  line = ((first > smin) ? first : smin) - 1;
+  this->last = (last < smax) ? last : smax;
+}
+
+boolean Core_GFX_PolygonScan::nextLine(int16_t &l) {
+  uint8_t i, j, e;
+
+  if (++line > last) return false;
+
+  // Step the active edges onto this line, dropping the finished ones
+  for (i = j = 0; i < actives; i++) {
+    e = active[i];
+    if (edge[e].end <= line) continue;
+    edge[e].t += edge[e].dt;
+    active[j++] = e;
+  }
+  actives = j;
+
+  // Pull in the edges that start here. On the first line of a clipped
+  // scan they may have started earlier and are advanced to catch up.
+  while ((pending < edges) && (edge[pending].start <= line)) {
+    e = pending++;
+    if (edge[e].end <= line) continue;
+    edge[e].t += edge[e].dt * (line - edge[e].start);
+    active[actives++] = e;
+  }
+
+  // Keep the list sorted by crossing, it is nearly sorted already
+  for (i = 1; i < actives; i++) {
+    e = active[i];
+    for (j = i; (j > 0) && (edge[active[j-1]].t > edge[e].t); j--)
+      active[j] = active[j-1];
+    active[j] = e;
+  }
+
+  span = 0;
+  l = line;
+  return true;
+}
+
+boolean Core_GFX_PolygonScan::nextSpan(int16_t &from, int16_t &to) {
+  if (span + 1 >= actives) return false;
+  from = edge[active[span]].t >> 16;
+  to   = edge[active[span + 1]].t >> 16;
+  span += 2;
+  return true;
+}
+
 /***************************************************************************/
 // code for the GFX button UI element
 
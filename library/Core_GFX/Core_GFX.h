@@ -7,9 +7,20 @@
 #else
  #include "WProgram.h"
 #endif
+#include "gfxfont.h"
 
 #define swap(a, b) { int16_t t = a; a = b; b = t; }
 
+// Most vertices fillPolygon() accepts. Coordinates must stay within +-16383.
+#define GFX_POLYGON_MAX 16
+
+// Saved viewports pushViewport() can nest
+#define GFX_VIEWPORT_DEPTH 3
+
+typedef struct {
+  int16_t x, y;
+} GFXpoint;
+
 class Core_GFX : public Print {
 
  public:
@@ -29,24 +40,35 @@ class Core_GFX : public Print {
     drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color),
     fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color),
     fillScreen(uint16_t color),
-    invertDisplay(boolean i);
+    fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color),
+    fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+      int16_t x2, int16_t y2, uint16_t color),
+    fillRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
+      int16_t radius, uint16_t color),
+    fillPolygon(const GFXpoint *pts, uint8_t n, uint16_t color),
+    drawGlyph(int16_t x, int16_t y, uint16_t glyph, uint16_t color,
+      uint16_t bg, uint8_t size),
+    invertDisplay(boolean i),
+    drawPixels(const GFXpoint *pts, uint16_t n, uint16_t color);
+
+  // Bracket a run of drawing calls. Devices may defer their per primitive
+  // bookkeeping (dirty region) to endWrite(). Calls nest.
+  virtual void
+    startWrite(void),
+    endWrite(void);
 
   // These exist only with Core_GFX (no subclass overrides)
   void
 	drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color),
     drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername,
       uint16_t color),
-    fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color),
     fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername,
       int16_t delta, uint16_t color),
     drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
       int16_t x2, int16_t y2, uint16_t color),
-    fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
-      int16_t x2, int16_t y2, uint16_t color),
     drawRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
       int16_t radius, uint16_t color),
-    fillRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
-      int16_t radius, uint16_t color),
+    drawPolygon(const GFXpoint *pts, uint8_t n, uint16_t color),
     drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
       int16_t w, int16_t h, uint16_t color),
     drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
@@ -62,8 +84,23 @@ class Core_GFX : public Print {
     setTextWrap(boolean w),
     setRotation(uint8_t r),
 	setTextDirection(uint8_t d),
+	setFont(const GFXfont *f = NULL),
+	setOrigin(int16_t x, int16_t y),
+	setClipRect(int16_t x, int16_t y, int16_t w, int16_t h),
+	resetClipRect(void),
+	pushViewport(int16_t x, int16_t y, int16_t w, int16_t h),
+	popViewport(void),
 	cp437(boolean x=true);
 
+  // Glyph index of a Unicode code point in the current font, or GFX_NO_GLYPH
+  uint16_t glyphIndex(uint16_t codepoint) const;
+
+  // Streaming UTF-8 decoder, for any text sink with its own state (both
+  // zero to start). Returns true once 'cp' holds a complete code point.
+  static boolean decodeUTF8(uint8_t c, uint8_t &pending, uint16_t &codepoint,
+    uint16_t &cp);
+  const GFXfont *getFont(void) const { return font; }
+
 #if ARDUINO >= 100
   virtual size_t write(uint8_t);
 #else
@@ -82,6 +119,7 @@ class Core_GFX : public Print {
   */
   int16_t height(void) const ;
   int16_t width(void) const ;
+  void getClipRect(int16_t &x, int16_t &y, int16_t &w, int16_t &h) const;
 
   uint8_t getRotation(void)const ;
 
@@ -91,23 +129,81 @@ class Core_GFX : public Print {
 
 
  protected:
+  boolean outsideClip(int16_t x, int16_t y, int16_t w, int16_t h) const;
+
+  // Called whenever the clip rectangle changes, for devices that keep their
+  // own copy of it
+  virtual void clipChanged(void);
+
+  // Pixel sink of the plot*() algorithms (Core_GFX_T.h). Here they go
+  // through the virtual drawPixel(), Core_GFX_T devices shadow them.
+  void writePixel(int16_t x, int16_t y, uint16_t color) {
+    drawPixel(x, y, color);
+  }
+  void markDirty(int16_t, int16_t, int16_t, int16_t) { }
+
+  template <class Sink> static void
+    plotCircle(Sink &s, int16_t x0, int16_t y0, int16_t r, uint8_t corners,
+      uint16_t color);
+  template <class Sink> static void
+    plotBitmap(Sink &s, int16_t x, int16_t y, const uint8_t *bitmap,
+      int16_t w, int16_t h, uint16_t color, uint16_t bg, boolean xbm);
+  template <class Sink> static void
+    plotGlyph(Sink &s, int16_t x, int16_t y, uint16_t glyph, uint16_t color,
+      uint16_t bg, uint8_t size);
+
   const int16_t
   WIDTH, HEIGHT;   // This is the 'raw' display w/h - never changes
   int16_t
     _width, _height, // Display w/h as modified by current rotation
-    cursor_x, cursor_y;
+    cursor_x, cursor_y,
+    origin_x, origin_y, // Added to every coordinate a primitive gets
+    clip_x0, clip_y0,   // Drawable area in screen coordinates, inclusive.
+    clip_x1, clip_y1;   // Primitives clip against it once, up front.
+  struct {
+    int16_t ox, oy, x0, y0, x1, y1;
+  } viewport[GFX_VIEWPORT_DEPTH];
+  uint8_t
+    viewports;
   uint16_t
     textcolor, textbgcolor;
   uint8_t
     textsize,
     rotation,
 	textdirection = 0,
-	utf8handle = 0x00;
+	utf8state = 0;   // UTF-8 continuation bytes still expected
+  uint16_t
+	utf8codepoint;   // Code point being assembled by write()
+  const GFXfont
+	*font;
   boolean
 	  wrap;   // If set, 'wrap' text at right edge of display
 
 };
 
+// Scanline polygon rasteriser, even-odd rule, for fillPolygon() and friends.
+// Edges wait in an edge table sorted by their first line and move to an
+// active edge list kept sorted by crossing, so each line costs only its own
+// edges. With 'columns' set the scan runs along x and the spans are
+// vertical, which is what page organised framebuffers want.
+class Core_GFX_PolygonScan {
+
+ public:
+  Core_GFX_PolygonScan(const GFXpoint *pts, uint8_t n, boolean columns,
+    int16_t first, int16_t last);
+  boolean nextLine(int16_t &line);
+  boolean nextSpan(int16_t &from, int16_t &to);
+
+ private:
+  struct {
+    int16_t start, end;   // Lines [start, end) the edge crosses
+    int32_t t, dt;        // 16.16 crossing on the current line and its step
+  } edge[GFX_POLYGON_MAX];
+  uint8_t active[GFX_POLYGON_MAX];
+  uint8_t edges, pending, actives, span;
+  int16_t line, last;
+};
+
 class Core_GFX_Button {
 
  public:
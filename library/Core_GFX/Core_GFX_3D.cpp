@@ -0,0 +1,177 @@
+/*
+Fixed point 3D wireframes for Core_GFX.
+*/
+
+#include "Core_GFX_3D.h"
+#ifdef __AVR__
+ #include <avr/pgmspace.h>
+#elif defined(ESP8266)
+ #include <pgmspace.h>
+#endif
+#ifndef pgm_read_byte
+ #define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#endif
+#ifndef pgm_read_word
+ #define pgm_read_word(addr) (*(const unsigned short *)(addr))
+#endif
+
+#define HIDDEN    ((int16_t)0x8000)   // projected x of a vertex behind the eye
+#define SCREEN_MAX 16383             // projected coordinates are clamped here
+
+// Quarter wave, sin(i * 90 / 64 degrees) in Q1.15
+static const int16_t sineTable[65] PROGMEM = {
+      0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+   6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+  12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+  18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+  23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+  27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+  30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+  32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+  32767
+};
+
+int16_t gfxSin(uint8_t a) {
+  uint8_t i = a & 63;
+  int16_t s;
+
+  if (a & 64) i = 64 - i;
+  s = pgm_read_word(&sineTable[i]);
+  return (a & 128) ? -s : s;
+}
+
+int16_t gfxCos(uint8_t a) {
+  return gfxSin(a + 64);
+}
+
+// Q1.15 product
+static inline int16_t mulQ15(int16_t a, int16_t b) {
+  return ((int32_t)a * b) >> 15;
+}
+
+static inline int16_t clampScreen(int32_t v) {
+  if (v > SCREEN_MAX) return SCREEN_MAX;
+  if (v < -SCREEN_MAX) return -SCREEN_MAX;
+  return v;
+}
+
+Core_GFX_Mesh::Core_GFX_Mesh(const GFXvertex *vertices, uint8_t vertexCount,
+  const GFXedge *edges, uint8_t edgeCount, GFXpoint *screen)
+  : vertices(vertices), edges(edges), screen(screen),
+    vertexCount(vertexCount), edgeCount(edgeCount),
+    tx(0), ty(0), tz(0), focal(64), cx(0), cy(0),
+    x0(0), y0(0), x1(-1), y1(-1)
+{
+  setAngles(0, 0, 0);
+}
+
+// m = Rz * Ry * Rx
+void Core_GFX_Mesh::setAngles(uint8_t ax, uint8_t ay, uint8_t az) {
+  int16_t sx = gfxSin(ax), cxa = gfxCos(ax),
+          sy = gfxSin(ay), cya = gfxCos(ay),
+          sz = gfxSin(az), cza = gfxCos(az),
+          sxsy = mulQ15(sx, sy), cxsy = mulQ15(cxa, sy);
+
+  m[0][0] = mulQ15(cya, cza);
+  m[0][1] = mulQ15(sxsy, cza) - mulQ15(cxa, sz);
+  m[0][2] = mulQ15(cxsy, cza) + mulQ15(sx, sz);
+  m[1][0] = mulQ15(cya, sz);
+  m[1][1] = mulQ15(sxsy, sz) + mulQ15(cxa, cza);
+  m[1][2] = mulQ15(cxsy, sz) - mulQ15(sx, cza);
+  m[2][0] = -sy;
+  m[2][1] = mulQ15(sx, cya);
+  m[2][2] = mulQ15(cxa, cya);
+}
+
+void Core_GFX_Mesh::setPosition(int16_t x, int16_t y, int16_t z) {
+  tx = x;
+  ty = y;
+  tz = z;
+}
+
+// Screen x = cx + focal * x / z. Vertex coordinates up to +-2047 and a
+// focal length up to 1000 stay within 32 bits.
+void Core_GFX_Mesh::setProjection(int16_t f, int16_t x, int16_t y) {
+  focal = f;
+  cx = x;
+  cy = y;
+}
+
+// Vertex i in eye space, Q8.8
+void Core_GFX_Mesh::transform(uint8_t i, int32_t &x, int32_t &y,
+  int32_t &z) const {
+  int32_t vx = (int16_t)pgm_read_word(&vertices[i].x),
+          vy = (int16_t)pgm_read_word(&vertices[i].y),
+          vz = (int16_t)pgm_read_word(&vertices[i].z);
+
+  x = ((m[0][0] * vx + m[0][1] * vy + m[0][2] * vz) >> 7) + (int32_t)tx * 256;
+  y = ((m[1][0] * vx + m[1][1] * vy + m[1][2] * vz) >> 7) + (int32_t)ty * 256;
+  z = ((m[2][0] * vx + m[2][1] * vy + m[2][2] * vz) >> 7) + (int32_t)tz * 256;
+}
+
+boolean Core_GFX_Mesh::project(int32_t x, int32_t y, int32_t z,
+  GFXpoint &p) const {
+  if (z < GFX_MESH_NEAR) return false;
+  p.x = clampScreen(cx + x * focal / z);
+  p.y = clampScreen(cy + y * focal / z);
+  return true;
+}
+
+void Core_GFX_Mesh::grow(const GFXpoint &p) {
+  if (x0 > x1) {
+    x0 = x1 = p.x;
+    y0 = y1 = p.y;
+    return;
+  }
+  if (p.x < x0) x0 = p.x;
+  if (p.x > x1) x1 = p.x;
+  if (p.y < y0) y0 = p.y;
+  if (p.y > y1) y1 = p.y;
+}
+
+void Core_GFX_Mesh::draw(Core_GFX &gfx, uint16_t color) {
+  int32_t ax, ay, az, bx, by, bz, t;
+  GFXpoint pa, pb;
+  uint8_t i, a, b;
+
+  for (i = 0; i < vertexCount; i++) {
+    transform(i, ax, ay, az);
+    if (!project(ax, ay, az, screen[i]))
+      screen[i].x = HIDDEN;
+  }
+
+  x0 = y0 = 0;
+  x1 = y1 = -1;
+  for (i = 0; i < edgeCount; i++) {
+    a = pgm_read_byte(&edges[i].a);
+    b = pgm_read_byte(&edges[i].b);
+    pa = screen[a];
+    pb = screen[b];
+    if ((pa.x == HIDDEN) && (pb.x == HIDDEN)) continue;
+    if ((pa.x == HIDDEN) || (pb.x == HIDDEN)) {
+      // Cut the edge where it crosses the near plane, t in Q8
+      transform(a, ax, ay, az);
+      transform(b, bx, by, bz);
+      if (pa.x == HIDDEN) {
+        t = ((GFX_MESH_NEAR - az) << 8) / (bz - az);
+        project(ax + (((bx - ax) * t) >> 8), ay + (((by - ay) * t) >> 8),
+          GFX_MESH_NEAR, pa);
+      } else {
+        t = ((GFX_MESH_NEAR - bz) << 8) / (az - bz);
+        project(bx + (((ax - bx) * t) >> 8), by + (((ay - by) * t) >> 8),
+          GFX_MESH_NEAR, pb);
+      }
+    }
+    gfx.drawLine(pa.x, pa.y, pb.x, pb.y, color);
+    grow(pa);
+    grow(pb);
+  }
+}
+
+// Clear what the last draw() covered
+void Core_GFX_Mesh::erase(Core_GFX &gfx, uint16_t color) {
+  if (x0 > x1) return;
+  gfx.fillRect(x0, y0, x1 - x0 + 1, y1 - y0 + 1, color);
+  x0 = y0 = 0;
+  x1 = y1 = -1;
+}
@@ -0,0 +1,69 @@
+#ifndef _Core_GFX_3D_H
+#define _Core_GFX_3D_H
+
+/*
+Fixed point 3D wireframes for Core_GFX.
+
+A mesh is an indexed vertex list and an edge list, both in PROGMEM. Each
+draw() rotates the original vertices by a matrix composed from three
+angles, so no error builds up from frame to frame:
+
+  matrix          Q1.15, from a quarter wave sine table
+  eye space       Q8.8 (vertex units * 256), 32 bit
+  screen          integer perspective divide per vertex
+
+Edges that cross the near plane are cut there, the rest go to the
+display's drawLine(), which clips them against the clip rectangle.
+erase() clears the bounding box of the last draw().
+
+Angles are 0..255 for a full turn, GFX_ANGLE() converts degrees.
+*/
+
+#include "Core_GFX.h"
+
+#define GFX_ANGLE(deg) ((uint8_t)((long)(deg) * 256 / 360))
+#define GFX_Q15_ONE    32767
+#define GFX_MESH_NEAR  256     // Q8.8: nothing is drawn closer than 1 unit
+
+typedef struct {
+  int16_t x, y, z;
+} GFXvertex;
+
+typedef struct {
+  uint8_t a, b;               // vertex indexes
+} GFXedge;
+
+// Q1.15 sine and cosine of a 0..255 angle
+int16_t gfxSin(uint8_t a);
+int16_t gfxCos(uint8_t a);
+
+class Core_GFX_Mesh {
+
+ public:
+  // screen holds the projected vertices, one GFXpoint per vertex
+  Core_GFX_Mesh(const GFXvertex *vertices, uint8_t vertexCount,
+    const GFXedge *edges, uint8_t edgeCount, GFXpoint *screen);
+
+  void
+    setAngles(uint8_t ax, uint8_t ay, uint8_t az),  // rotate z(y(x(v)))
+    setPosition(int16_t x, int16_t y, int16_t z),   // added after rotating
+    setProjection(int16_t focal, int16_t cx, int16_t cy),
+    draw(Core_GFX &gfx, uint16_t color),
+    erase(Core_GFX &gfx, uint16_t color);
+
+ private:
+  void transform(uint8_t i, int32_t &x, int32_t &y, int32_t &z) const;
+  boolean project(int32_t x, int32_t y, int32_t z, GFXpoint &p) const;
+  void grow(const GFXpoint &p);
+
+  const GFXvertex *vertices;
+  const GFXedge *edges;
+  GFXpoint *screen;
+  uint8_t vertexCount, edgeCount;
+  int16_t m[3][3];            // Q1.15 rotation
+  int16_t tx, ty, tz;
+  int16_t focal, cx, cy;
+  int16_t x0, y0, x1, y1;     // bounding box of the last draw()
+};
+
+#endif // _Core_GFX_3D_H
@@ -0,0 +1,203 @@
+#ifndef _Core_GFX_T_H
+#define _Core_GFX_T_H
+
+/*
+Static dispatch flavour of Core_GFX.
+
+  class MyDisplay : public Core_GFX_T<MyDisplay> { ... };
+
+The per-pixel primitives (circle outlines, bitmaps, glyphs) are written
+once, as the plot*() templates below, against a pixel sink. Core_GFX runs
+them with itself as the sink, so every pixel is a virtual drawPixel() call.
+Core_GFX_T runs them with the derived display as the sink, so they call
+Device::writePixel() directly and it inlines into the loops.
+
+A Device provides, in its header so it can be inlined:
+
+  void writePixel(int16_t x, int16_t y, uint16_t color);
+    Same as drawPixel() (origin, clip rectangle, rotation), minus the dirty
+    bookkeeping.
+  void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+    Records the box a primitive may have touched, once per primitive.
+
+Calls through a Core_GFX pointer or reference still work, through the
+virtual path.
+*/
+
+#include "Core_GFX.h"
+#ifdef __AVR__
+ #include <avr/pgmspace.h>
+#elif defined(ESP8266)
+ #include <pgmspace.h>
+#elif !defined(pgm_read_byte)
+ #define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#endif
+
+template <class Device>
+class Core_GFX_T : public Core_GFX {
+
+ public:
+  Core_GFX_T(int16_t w, int16_t h) : Core_GFX(w, h) { }
+
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    if (outsideClip(x0 - r, y0 - r, 2*r + 1, 2*r + 1)) return;
+    plotCircle(device(), x0, y0, r, 0x10 | 0xF, color);
+    device().markDirty(x0 - r, y0 - r, 2*r + 1, 2*r + 1);
+  }
+
+  void drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
+    uint8_t cornername, uint16_t color) {
+    if (outsideClip(x0 - r, y0 - r, 2*r + 1, 2*r + 1)) return;
+    plotCircle(device(), x0, y0, r, cornername, color);
+    device().markDirty(x0 - r, y0 - r, 2*r + 1, 2*r + 1);
+  }
+
+  void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
+    int16_t r, uint16_t color) {
+    if (outsideClip(x, y, w, h)) return;
+    device().drawFastHLine(x+r  , y    , w-2*r, color); // Top
+    device().drawFastHLine(x+r  , y+h-1, w-2*r, color); // Bottom
+    device().drawFastVLine(x    , y+r  , h-2*r, color); // Left
+    device().drawFastVLine(x+w-1, y+r  , h-2*r, color); // Right
+    plotCircle(device(), x+r    , y+r    , r, 1, color);
+    plotCircle(device(), x+w-r-1, y+r    , r, 2, color);
+    plotCircle(device(), x+w-r-1, y+h-r-1, r, 4, color);
+    plotCircle(device(), x+r    , y+h-r-1, r, 8, color);
+    device().markDirty(x, y, w, h);
+  }
+
+  void drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+    int16_t w, int16_t h, uint16_t color) {
+    if (outsideClip(x, y, w, h)) return;
+    plotBitmap(device(), x, y, bitmap, w, h, color, color, false);
+    device().markDirty(x, y, w, h);
+  }
+
+  void drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+    int16_t w, int16_t h, uint16_t color, uint16_t bg) {
+    if (outsideClip(x, y, w, h)) return;
+    plotBitmap(device(), x, y, bitmap, w, h, color, bg, false);
+    device().markDirty(x, y, w, h);
+  }
+
+  void drawXBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+    int16_t w, int16_t h, uint16_t color) {
+    if (outsideClip(x, y, w, h)) return;
+    plotBitmap(device(), x, y, bitmap, w, h, color, color, true);
+    device().markDirty(x, y, w, h);
+  }
+
+  void drawGlyph(int16_t x, int16_t y, uint16_t glyph, uint16_t color,
+    uint16_t bg, uint8_t size) {
+    if (outsideClip(x, y, GFX_GLYPH_WIDTH * size, 8 * size)) return;
+    plotGlyph(device(), x, y, glyph, color, bg, size);
+    device().markDirty(x, y, GFX_GLYPH_WIDTH * size, 8 * size);
+  }
+
+ protected:
+  Device &device(void) { return static_cast<Device &>(*this); }
+};
+
+/***************************************************************************/
+// Pixel algorithms shared by Core_GFX and Core_GFX_T
+
+// Midpoint circle. Corner bits 1/2/4/8 pick the quadrants like
+// drawCircleHelper(), 0x10 adds the four axis points of a full circle.
+template <class Sink>
+void Core_GFX::plotCircle(Sink &s, int16_t x0, int16_t y0, int16_t r,
+  uint8_t corners, uint16_t color) {
+  int16_t f     = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x     = 0;
+  int16_t y     = r;
+
+  if (corners & 0x10) {
+    s.writePixel(x0  , y0+r, color);
+    s.writePixel(x0  , y0-r, color);
+    s.writePixel(x0+r, y0  , color);
+    s.writePixel(x0-r, y0  , color);
+  }
+
+  while (x<y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f     += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f     += ddF_x;
+    if (corners & 0x4) {
+      s.writePixel(x0 + x, y0 + y, color);
+      s.writePixel(x0 + y, y0 + x, color);
+    }
+    if (corners & 0x2) {
+      s.writePixel(x0 + x, y0 - y, color);
+      s.writePixel(x0 + y, y0 - x, color);
+    }
+    if (corners & 0x8) {
+      s.writePixel(x0 - y, y0 + x, color);
+      s.writePixel(x0 - x, y0 + y, color);
+    }
+    if (corners & 0x1) {
+      s.writePixel(x0 - y, y0 - x, color);
+      s.writePixel(x0 - x, y0 - y, color);
+    }
+  }
+}
+
+// Row major 1-bit PROGMEM bitmap, MSB first (or LSB first for XBM). Clear
+// bits are drawn in bg unless bg equals color.
+template <class Sink>
+void Core_GFX::plotBitmap(Sink &s, int16_t x, int16_t y,
+  const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg,
+  boolean xbm) {
+  int16_t i, j, byteWidth = (w + 7) / 8;
+  uint8_t bit;
+
+  for(j=0; j<h; j++) {
+    for(i=0; i<w; i++ ) {
+      bit = xbm ? (1 << (i & 7)) : (128 >> (i & 7));
+      if(pgm_read_byte(bitmap + j * byteWidth + i / 8) & bit) {
+        s.writePixel(x+i, y+j, color);
+      }
+      else if (bg != color) {
+        s.writePixel(x+i, y+j, bg);
+      }
+    }
+  }
+}
+
+// Glyph of the sink's current font, scaled by size
+template <class Sink>
+void Core_GFX::plotGlyph(Sink &s, int16_t x, int16_t y, uint16_t glyph,
+  uint16_t color, uint16_t bg, uint8_t size) {
+	uint8_t row,column,FontHeight,FontWidth;
+	uint8_t F,Z;
+	uint8_t tmp;
+	const uint8_t *bitmap = s.font->bitmap + glyph * GFX_GLYPH_WIDTH;
+
+	// x ширина x+5 точек символ
+	FontHeight=8 * size;
+	FontWidth=GFX_GLYPH_WIDTH * size;
+	for (column=0; column<FontWidth;column++ )
+	{
+		Z=column/ size;
+		tmp= pgm_read_byte(bitmap + Z);
+
+		for (row= 0;row<FontHeight;row++)
+		{
+			F = (row / size);
+			if ((tmp & (1 << F)) != 0) {
+				s.writePixel(x + column, y + row, color);
+			}
+			else if (bg != color)
+			{
+				s.writePixel(x + column, y + row, bg);
+			};
+		}
+	}
+}
+
+#endif // _Core_GFX_T_H
@@ -0,0 +1,26 @@
+// Font structures for Core_GFX. A font is a flat PROGMEM array of 5-column
+// glyphs plus a table that maps Unicode code points onto glyph indexes, so a
+// font only has to carry the glyphs it actually uses.
+
+#ifndef _GFXFONT_H_
+#define _GFXFONT_H_
+
+#include <stdint.h>
+
+#define GFX_GLYPH_WIDTH 5       // Column bytes per glyph
+#define GFX_NO_GLYPH    0xFFFF  // Returned for code points the font lacks
+
+// A run of consecutive code points drawn by consecutive glyphs.
+typedef struct {
+  uint16_t first;   // First code point of the run
+  uint16_t last;    // Last code point of the run (inclusive)
+  uint16_t glyph;   // Glyph index of 'first'
+} GFXrange;
+
+typedef struct {
+  const uint8_t  *bitmap;     // GFX_GLYPH_WIDTH bytes per glyph, LSB on top
+  const GFXrange *range;      // Runs sorted by 'first', tried first to last
+  uint8_t         rangeCount;
+} GFXfont;
+
+#endif // _GFXFONT_H_
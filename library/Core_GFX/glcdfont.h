@@ -9,6 +9,7 @@
 #else
  #define PROGMEM
 #endif
+#include "gfxfont.h"
 
 // Standard ASCII 5x8 font + russian
 
@@ -243,5 +244,30 @@ static  unsigned char font5x8[][5] PROGMEM =
     { 0x58, 0x24, 0x24, 0x24, 0x7C }  // я	256
 		};
 
+// Unicode code point -> font5x8 glyph index. Glyph n is font code n+32 in
+// the table above (cp1251 layout). Keep the list sorted by code point and
+// keep the ASCII run first: Core_GFX looks it up without searching.
+static const GFXrange font5x8Ranges[] PROGMEM =
+{
+    { 0x0020, 0x007E,   0 },    // ASCII
+    { 0x00A6, 0x00A6, 134 },    // ¦
+    { 0x0401, 0x0401, 111 },    // Ё
+    { 0x0404, 0x0404, 138 },    // Є Ukrain
+    { 0x0406, 0x0406, 146 },    // І Ukrain
+    { 0x0407, 0x0407, 143 },    // Ї Ukrain
+    { 0x0410, 0x044F, 160 },    // А..я
+    { 0x0451, 0x0451, 152 },    // ё
+    { 0x0454, 0x0454, 154 },    // є Ukrain
+    { 0x0456, 0x0456, 147 },    // і Ukrain
+    { 0x0457, 0x0457, 159 },    // ї Ukrain
+};
+
+static const GFXfont font5x8Font =
+{
+    (const uint8_t *)font5x8,
+    font5x8Ranges,
+    sizeof(font5x8Ranges) / sizeof(font5x8Ranges[0])
+};
+
 
 #endif // FONT_H
@@ -0,0 +1,59 @@
+#ifndef FONT_H
+#define FONT_H
+
+// Generated by tools/fontsubset.py, do not edit.
+// 20 of 224 glyphs, 100 bytes
+
+#ifdef __AVR__
+ #include <avr/io.h>
+ #include <avr/pgmspace.h>
+#elif defined(ESP8266)
+ #include <pgmspace.h>
+#else
+ #define PROGMEM
+#endif
+#include "gfxfont.h"
+
+static  unsigned char font5x8[][5] PROGMEM =
+{
+    { 0x00, 0x00, 0x00, 0x00, 0x00 },  // sp U+0020
+    { 0xC4, 0xC8, 0x10, 0x26, 0x46 },  // %  U+0025
+    { 0x08, 0x08, 0x3E, 0x08, 0x08 },  // +  U+002B
+    { 0x00, 0x00, 0x50, 0x30, 0x00 },  // ,  U+002C
+    { 0x10, 0x10, 0x10, 0x10, 0x10 },  // -  U+002D
+    { 0x00, 0x60, 0x60, 0x00, 0x00 },  // .  U+002E
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E },  // 0  U+0030
+    { 0x00, 0x42, 0x7F, 0x40, 0x00 },  // 1  U+0031
+    { 0x42, 0x61, 0x51, 0x49, 0x46 },  // 2  U+0032
+    { 0x21, 0x41, 0x45, 0x4B, 0x31 },  // 3  U+0033
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 },  // 4  U+0034
+    { 0x27, 0x45, 0x45, 0x45, 0x39 },  // 5  U+0035
+    { 0x3C, 0x4A, 0x49, 0x49, 0x30 },  // 6  U+0036
+    { 0x01, 0x71, 0x09, 0x05, 0x03 },  // 7  U+0037
+    { 0x36, 0x49, 0x49, 0x49, 0x36 },  // 8  U+0038
+    { 0x06, 0x49, 0x49, 0x29, 0x1E },  // 9  U+0039
+    { 0x00, 0x36, 0x36, 0x00, 0x00 },  // :  U+003A
+    { 0x08, 0x7E, 0x09, 0x01, 0x02 },  // f  U+0066
+    { 0x7C, 0x14, 0x14, 0x14, 0x08 },  // p  U+0070
+    { 0x48, 0x54, 0x54, 0x54, 0x20 }   // s  U+0073
+};
+
+static const GFXrange font5x8Ranges[] PROGMEM =
+{
+    { 0x0020, 0x0020,   0 },
+    { 0x0025, 0x0025,   1 },
+    { 0x002B, 0x002E,   2 },
+    { 0x0030, 0x003A,   6 },
+    { 0x0066, 0x0066,  17 },
+    { 0x0070, 0x0070,  18 },
+    { 0x0073, 0x0073,  19 },
+};
+
+static const GFXfont font5x8Font =
+{
+    (const uint8_t *)font5x8,
+    font5x8Ranges,
+    sizeof(font5x8Ranges) / sizeof(font5x8Ranges[0])
+};
+
+#endif // FONT_H
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+"""Encode PBM frames as an ST7558 delta animation (see ST7558_Player.h).
+
+    animpack.py --fps 12 --loop frames/*.pbm -o anim.h
+    animpack.py --fps 25 --bin frames/*.pbm -o anim.bin
+
+Frames are given in order and must share one size. Each frame keeps only
+the page spans that changed since the frame before. Spans closer than
+--gap bytes are merged, since a new span costs 3 header bytes and a bus
+transfer of its own. --bin writes the raw stream, for an SD card or to
+send to ST7558_Player over a serial port. Sizes and the bytes each frame
+puts on the bus are reported on stderr.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from packbitmap import read_pbm, to_pages, c_array    # noqa: E402
+
+END = 0xFF
+LOOP = 0x01
+HEADER = 6
+RAM_WIDTH = 102
+PAGES = 9
+
+
+def spans(prev, cur, w, pages, gap):
+    """Changed (page, x, bytes) spans of cur against prev."""
+    out = []
+    for page in range(pages):
+        row = page * w
+        x = 0
+        while x < w:
+            if prev[row + x] == cur[row + x]:
+                x += 1
+                continue
+            start = end = x
+            x += 1
+            while x < w and x - end <= gap:
+                if prev[row + x] != cur[row + x]:
+                    end = x
+                x += 1
+            while end - start + 1 > 255:
+                out.append((page, start, cur[row + start:row + start + 255]))
+                start += 255
+            out.append((page, start, cur[row + start:row + end + 1]))
+            x = end + 1
+    return out
+
+
+def frame_bytes(prev, cur, w, pages, gap):
+    data = []
+    for page, x, span in spans(prev, cur, w, pages, gap):
+        data += [page, x, len(span)] + list(span)
+    return data + [END]
+
+
+def encode(frames, w, pages, fps, loop, gap):
+    data = [w, pages, fps, LOOP if loop else 0,
+            len(frames) & 0xFF, len(frames) >> 8]
+    sizes = []
+    prev = [0] * (w * pages)
+    for cur in frames:
+        f = frame_bytes(prev, cur, w, pages, gap)
+        sizes.append(len(f))
+        data += f
+        prev = cur
+    if loop:
+        f = frame_bytes(prev, frames[0], w, pages, gap)
+        sizes.append(len(f))
+        data += f
+    return data, sizes
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument('frames', nargs='+', help='PBM frames (P1 or P4), in order')
+    ap.add_argument('--fps', type=int, default=10, help='frame rate (default 10)')
+    ap.add_argument('--loop', action='store_true', help='add a frame back to the first')
+    ap.add_argument('--gap', type=int, default=3,
+                    help='merge spans at most this many bytes apart (default 3)')
+    ap.add_argument('--invert', action='store_true', help='white pixels are dark')
+    ap.add_argument('--name', help='array name (default from the output file)')
+    ap.add_argument('--bin', action='store_true', help='write the raw stream')
+    ap.add_argument('-o', '--output', required=True, help='file to write')
+    args = ap.parse_args()
+
+    frames = []
+    size = None
+    for path in args.frames:
+        w, h, rows = read_pbm(path)
+        if size and size != (w, h):
+            sys.exit('%s: %dx%d, the first frame is %dx%d' % ((path, w, h) + size))
+        size = (w, h)
+        frames.append(to_pages(w, h, rows, args.invert))
+    w, h = size
+    pages = (h + 7) // 8
+    if w > RAM_WIDTH or pages > PAGES:
+        sys.exit('frames are limited to %dx%d pixels' % (RAM_WIDTH, PAGES * 8))
+    if not 0 < args.fps < 256:
+        sys.exit('--fps takes 1 to 255')
+
+    data, sizes = encode(frames, w, pages, args.fps, args.loop, args.gap)
+
+    if args.bin:
+        open(args.output, 'wb').write(bytes(data))
+    else:
+        name = args.name or re.sub(r'\W', '_',
+                                   os.path.splitext(os.path.basename(args.output))[0])
+        text = ('// Generated by tools/animpack.py, do not edit.\n\n'
+                '#ifdef __AVR__\n #include <avr/pgmspace.h>\n'
+                '#elif defined(ESP8266)\n #include <pgmspace.h>\n'
+                '#else\n #define PROGMEM\n#endif\n\n' +
+                c_array(name, data, '%d frames of %dx%d at %d fps, %d bytes'
+                        % (len(frames), w, h, args.fps, len(data))))
+        open(args.output, 'w').write(text)
+
+    raw = len(frames) * w * pages
+    sys.stderr.write('%d frames %dx%d: %d bytes (%d raw, %.0f%%), '
+                     'bus bytes per frame avg %.0f max %d\n'
+                     % (len(frames), w, h, len(data), raw, 100.0 * len(data) / raw,
+                        sum(sizes) / float(len(sizes)), max(sizes)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""Generate a glyph subset of the Core_GFX 5x8 font.
+
+Writes a header with the same font5x8 / font5x8Ranges / font5x8Font names
+as glcdfont.h but only the glyphs a project declares, so the unused glyphs
+never reach flash. Enable it with enableFontSubset in Core_GFX.cpp.
+
+    fontsubset.py --chars "0123456789.-fps" -o glcdfont_subset.h
+    fontsubset.py --scan sketch.ino graphics.c -o glcdfont_subset.h
+
+--scan collects every character of every string and character literal in
+the given sources. Both options may be combined.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+FONT = os.path.join(HERE, '..', 'library', 'Core_GFX', 'glcdfont.h')
+
+GLYPH = re.compile(r'\{\s*(0x[0-9A-Fa-f]+(?:\s*,\s*0x[0-9A-Fa-f]+){4})\s*\}')
+RANGE = re.compile(r'\{\s*0x([0-9A-Fa-f]+)\s*,\s*0x([0-9A-Fa-f]+)\s*,\s*(\d+)\s*\}')
+LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"|\'((?:[^\'\\\n]|\\.)+)\'')
+
+
+def load_font(path):
+    src = open(path, encoding='utf-8').read()
+    body, ranges = src.split('font5x8Ranges', 1)
+    glyphs = [[int(b, 16) for b in m.group(1).split(',')]
+              for m in GLYPH.finditer(body)]
+    cmap = {}
+    for m in RANGE.finditer(ranges.split('font5x8Font', 1)[0]):
+        first, last, glyph = int(m.group(1), 16), int(m.group(2), 16), int(m.group(3))
+        for cp in range(first, last + 1):
+            cmap[cp] = glyph + cp - first
+    return glyphs, cmap
+
+
+def scan(paths):
+    chars = set()
+    for path in paths:
+        text = open(path, encoding='utf-8', errors='replace').read()
+        for m in LITERAL.finditer(text):
+            lit = m.group(1) if m.group(1) is not None else m.group(2)
+            chars.update(re.sub(r'\\.', '', lit))
+    return chars
+
+
+def runs(cps):
+    out = []
+    for cp in cps:
+        if out and out[-1][1] == cp - 1:
+            out[-1][1] = cp
+        else:
+            out.append([cp, cp])
+    return out
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('--chars', default='', help='characters to keep')
+    ap.add_argument('--scan', nargs='*', default=[], help='sources to scan for literals')
+    ap.add_argument('--font', default=FONT, help='full font header (glcdfont.h)')
+    ap.add_argument('-o', '--output', default='-', help='header to write')
+    args = ap.parse_args()
+
+    glyphs, cmap = load_font(args.font)
+    wanted = set(args.chars) | scan(args.scan)
+    missing = sorted(c for c in wanted if ord(c) not in cmap and c >= ' ')
+    if missing:
+        sys.stderr.write('not in font, skipped: %s\n' % ''.join(missing))
+    cps = sorted(ord(c) for c in wanted if ord(c) in cmap)
+    if not cps:
+        sys.exit('fontsubset: no glyphs selected')
+
+    lines = []
+    lines.append('#ifndef FONT_H')
+    lines.append('#define FONT_H')
+    lines.append('')
+    lines.append('// Generated by tools/fontsubset.py, do not edit.')
+    lines.append('// %d of %d glyphs, %d bytes' % (len(cps), len(glyphs), len(cps) * 5))
+    lines.append('')
+    lines.append('#ifdef __AVR__')
+    lines.append(' #include <avr/io.h>')
+    lines.append(' #include <avr/pgmspace.h>')
+    lines.append('#elif defined(ESP8266)')
+    lines.append(' #include <pgmspace.h>')
+    lines.append('#else')
+    lines.append(' #define PROGMEM')
+    lines.append('#endif')
+    lines.append('#include "gfxfont.h"')
+    lines.append('')
+    lines.append('static  unsigned char font5x8[][5] PROGMEM =')
+    lines.append('{')
+    for i, cp in enumerate(cps):
+        g = glyphs[cmap[cp]]
+        sep = ',' if i < len(cps) - 1 else ' '
+        name = chr(cp) if cp > 0x20 else 'sp'
+        lines.append('    { %s }%s  // %-2s U+%04X' % (', '.join('0x%02X' % b for b in g), sep, name, cp))
+    lines.append('};')
+    lines.append('')
+    lines.append('static const GFXrange font5x8Ranges[] PROGMEM =')
+    lines.append('{')
+    glyph = 0
+    for first, last in runs(cps):
+        lines.append('    { 0x%04X, 0x%04X, %3d },' % (first, last, glyph))
+        glyph += last - first + 1
+    lines.append('};')
+    lines.append('')
+    lines.append('static const GFXfont font5x8Font =')
+    lines.append('{')
+    lines.append('    (const uint8_t *)font5x8,')
+    lines.append('    font5x8Ranges,')
+    lines.append('    sizeof(font5x8Ranges) / sizeof(font5x8Ranges[0])')
+    lines.append('};')
+    lines.append('')
+    lines.append('#endif // FONT_H')
+
+    out = '\n'.join(lines) + '\n'
+    if args.output == '-':
+        sys.stdout.write(out)
+    else:
+        open(args.output, 'w', encoding='utf-8').write(out)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""Pack PBM images into ST7558 packed bitmaps (see ST7558_Pack.h).
+
+    packbitmap.py splash.pbm -o splash.h
+    packbitmap.py --name logo --invert logo.pbm -o logo.h
+
+Black PBM pixels become dark pixels (set bits) unless --invert. The
+header gets one PROGMEM array per image, to draw with
+ST7558::drawPackedBitmap() or send with ST7558::displayPacked(). Sizes
+and the decoder's work per image are reported on stderr.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+LITERAL = 0x80    # control bytes below are literal runs
+MIN_RUN = 2       # shortest repeat run
+MAX_RUN = 0x7F + MIN_RUN
+MAX_LITERAL = 0x80
+
+
+def read_pbm(path):
+    """Return (w, h, rows) with rows[y][x] = 1 for black."""
+    data = open(path, 'rb').read()
+    tokens = []
+    pos = 0
+    # Magic, width, height; comments may sit between them
+    while len(tokens) < 3:
+        m = re.compile(rb'\s*(#[^\n]*\n\s*)*(\S+)').match(data, pos)
+        if not m:
+            sys.exit('%s: not a PBM file' % path)
+        tokens.append(m.group(2))
+        pos = m.end()
+    magic, w, h = tokens[0], int(tokens[1]), int(tokens[2])
+    if magic == b'P4':
+        pos += 1                        # single whitespace before the raster
+        stride = (w + 7) // 8
+        rows = [[(data[pos + y * stride + x // 8] >> (7 - x % 8)) & 1
+                 for x in range(w)] for y in range(h)]
+    elif magic == b'P1':
+        bits = [b - 48 for b in data[pos:] if b in b'01']
+        rows = [bits[y * w:(y + 1) * w] for y in range(h)]
+    else:
+        sys.exit('%s: only P1 and P4 PBM files are supported' % path)
+    return w, h, rows
+
+
+def to_pages(w, h, rows, invert=False):
+    """Page-format bytes: page by page, one byte per column, LSB on top."""
+    out = []
+    for page in range((h + 7) // 8):
+        for x in range(w):
+            b = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < h and rows[y][x] != invert:
+                    b |= 1 << bit
+            out.append(b)
+    return out
+
+
+def pack_runs(data):
+    """Run length code a byte string, without the size header."""
+    out = []
+    literal = []
+
+    def flush():
+        while literal:
+            chunk = literal[:MAX_LITERAL]
+            del literal[:MAX_LITERAL]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+
+    i = 0
+    while i < len(data):
+        n = 1
+        while i + n < len(data) and data[i + n] == data[i] and n < MAX_RUN:
+            n += 1
+        # A pair inside a literal is cheaper left in it
+        if n >= 3 or (n == MIN_RUN and not literal):
+            flush()
+            out.append(LITERAL | (n - MIN_RUN))
+            out.append(data[i])
+            i += n
+        else:
+            literal.append(data[i])
+            i += 1
+    flush()
+    return out
+
+
+def pack(w, h, pages):
+    if w > 255 or h > 255:
+        sys.exit('images are limited to 255 x 255 pixels')
+    return [w, h] + pack_runs(pages)
+
+
+def cost(packed):
+    """Control bytes, literal bytes and repeated bytes the decoder handles."""
+    i, controls, literal, repeated = 2, 0, 0, 0
+    while i < len(packed):
+        c = packed[i]
+        controls += 1
+        if c & LITERAL:
+            repeated += (c & 0x7F) + MIN_RUN
+            i += 2
+        else:
+            literal += c + 1
+            i += c + 2
+    return controls, literal, repeated
+
+
+def c_array(name, packed, comment):
+    lines = ['// %s' % comment,
+             'const uint8_t %s[] PROGMEM = {' % name]
+    for i in range(0, len(packed), 16):
+        lines.append('  ' + ', '.join('0x%02x' % b for b in packed[i:i + 16]) + ',')
+    lines.append('};')
+    return '\n'.join(lines) + '\n'
+
+
+def identifier(path):
+    return re.sub(r'\W', '_', os.path.splitext(os.path.basename(path))[0])
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument('images', nargs='+', help='PBM images (P1 or P4)')
+    ap.add_argument('--name', help='array name, single image only')
+    ap.add_argument('--invert', action='store_true', help='white pixels are dark')
+    ap.add_argument('-o', '--output', help='header to write (default stdout)')
+    args = ap.parse_args()
+    if args.name and len(args.images) > 1:
+        ap.error('--name takes a single image')
+
+    parts = ['// Generated by tools/packbitmap.py, do not edit.\n',
+             '#ifdef __AVR__\n #include <avr/pgmspace.h>\n'
+             '#elif defined(ESP8266)\n #include <pgmspace.h>\n'
+             '#else\n #define PROGMEM\n#endif\n']
+    for path in args.images:
+        w, h, rows = read_pbm(path)
+        pages = to_pages(w, h, rows, args.invert)
+        packed = pack(w, h, pages)
+        controls, literal, repeated = cost(packed)
+        name = args.name or identifier(path)
+        parts.append(c_array(name, packed, '%s: %dx%d, %d bytes packed from %d'
+                             % (os.path.basename(path), w, h, len(packed), len(pages))))
+        sys.stderr.write('%s: %dx%d  %d -> %d bytes (%.0f%%)  decode: %d runs, '
+                         '%d literal + %d repeated bytes\n'
+                         % (name, w, h, len(pages), len(packed),
+                            100.0 * len(packed) / len(pages),
+                            controls, literal, repeated))
+    text = '\n'.join(parts)
+    if args.output:
+        open(args.output, 'w').write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == '__main__':
+    main()